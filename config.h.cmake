@@ -118,6 +118,7 @@
 #cmakedefine HAVE_PTHREAD_SIGMASK 1
 #cmakedefine HAVE_READLINK 1
 #cmakedefine HAVE_REALPATH 1
+#cmakedefine HAVE_SCHED_GETCPU 1
 #cmakedefine HAVE_SETFD 1
 #cmakedefine HAVE_SIGACTION 1
 #cmakedefine HAVE_SLEEP 1
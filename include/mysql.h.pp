@@ -83,7 +83,7 @@ typedef struct st_net {
   my_bool unused2;
   my_bool compress;
   my_bool unused3;
-  unsigned char *unused;
+  void *compress_context;
   unsigned int last_errno;
   unsigned char error;
   my_bool unused4;
@@ -107,7 +107,8 @@ enum enum_cursor_type
   CURSOR_TYPE_NO_CURSOR= 0,
   CURSOR_TYPE_READ_ONLY= 1,
   CURSOR_TYPE_FOR_UPDATE= 2,
-  CURSOR_TYPE_SCROLLABLE= 4
+  CURSOR_TYPE_SCROLLABLE= 4,
+  PARAMETER_BATCH= 128
 };
 enum enum_mysql_set_option
 {
@@ -362,7 +363,8 @@ enum mysql_option
   MYSQL_OPT_SSL_ENFORCE,
   MYSQL_OPT_MAX_ALLOWED_PACKET, MYSQL_OPT_NET_BUFFER_LENGTH,
   MYSQL_OPT_TLS_VERSION,
-  MYSQL_OPT_SSL_MODE
+  MYSQL_OPT_SSL_MODE,
+  MYSQL_OPT_COMPRESSION_LZ4
 };
 struct st_mysql_options_extention;
 struct st_mysql_options {
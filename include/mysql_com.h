@@ -208,6 +208,26 @@
 /* Client no longer needs EOF packet */
 #define CLIENT_DEPRECATE_EOF (1UL << 24)
 
+/**
+  Can send several parameter sets in one COM_STMT_EXECUTE, with the
+  PARAMETER_BATCH flag. The server always advertises it, but only reads
+  the flag from clients that have set the capability. The bit is
+  CLIENT_OPTIONAL_RESULTSET_METADATA in MySQL 8.0, so clients ignore it
+  from servers of other versions than 5.7.
+*/
+#define CLIENT_STMT_PARAMETER_BATCH (1UL << 25)
+
+/**
+  Use LZ4 with a per-connection streaming context instead of zlib for the
+  compressed protocol. Only meaningful together with CLIENT_COMPRESS.
+  The bit is not free: it is CLIENT_PROGRESS in MariaDB and
+  CLIENT_CAPABILITY_EXTENSION in MySQL 8.0. So the server only advertises
+  and accepts it with --protocol-compression-lz4, clients only request it
+  when asked to, and they ignore it from servers of other versions than
+  5.7.
+*/
+#define CLIENT_COMPRESS_LZ4 (1UL << 29)
+
 #define CLIENT_SSL_VERIFY_SERVER_CERT (1UL << 30)
 #define CLIENT_REMEMBER_OPTIONS (1UL << 31)
 
@@ -245,6 +265,8 @@
                            | CLIENT_CAN_HANDLE_EXPIRED_PASSWORDS \
                            | CLIENT_SESSION_TRACK \
                            | CLIENT_DEPRECATE_EOF \
+                           | CLIENT_STMT_PARAMETER_BATCH \
+                           | CLIENT_COMPRESS_LZ4 \
 )
 
 /*
@@ -252,8 +274,9 @@
   If any of the optional flags is supported by the build it will be switched
   on before sending to the client during the connection handshake.
 */
-#define CLIENT_BASIC_FLAGS (((CLIENT_ALL_FLAGS & ~CLIENT_SSL) \
+#define CLIENT_BASIC_FLAGS ((((CLIENT_ALL_FLAGS & ~CLIENT_SSL) \
                                                & ~CLIENT_COMPRESS) \
+                                               & ~CLIENT_COMPRESS_LZ4) \
                                                & ~CLIENT_SSL_VERIFY_SERVER_CERT)
 
 /**
@@ -372,9 +395,10 @@ typedef struct st_net {
     queries in cache that have not stored its results yet
   */
   /*
-    Unused, please remove with the next incompatible ABI change.
+    Streaming context of the LZ4 compressed protocol, NULL when the
+    connection uses zlib or no compression.
   */
-  unsigned char *unused;
+  void *compress_context;
   unsigned int last_errno;
   unsigned char error; 
   my_bool unused4; /* Please remove with the next incompatible ABI change. */
@@ -464,7 +488,13 @@ enum enum_cursor_type
   CURSOR_TYPE_NO_CURSOR= 0,
   CURSOR_TYPE_READ_ONLY= 1,
   CURSOR_TYPE_FOR_UPDATE= 2,
-  CURSOR_TYPE_SCROLLABLE= 4
+  CURSOR_TYPE_SCROLLABLE= 4,
+  /*
+    Not a cursor type: the COM_STMT_EXECUTE packet holds several
+    parameter sets, one after another, to execute the statement with.
+    Only for connections with CLIENT_STMT_PARAMETER_BATCH.
+  */
+  PARAMETER_BATCH= 128
 };
 
 
@@ -522,6 +552,10 @@ unsigned long my_net_read(NET *net);
 #ifdef MY_GLOBAL_INCLUDED
 void my_net_set_write_timeout(NET *net, uint timeout);
 void my_net_set_read_timeout(NET *net, uint timeout);
+/* Default level of LZ4 protocol compression, the best compression */
+#define NET_COMPRESSION_DEFAULT_LEVEL 9
+my_bool my_net_set_compression_lz4(NET *net, uint level);
+void my_net_set_compression_level(NET *net, uint level);
 #endif
 
 struct rand_struct {
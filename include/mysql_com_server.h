@@ -38,4 +38,24 @@ struct st_net_server
 
 typedef struct st_net_server NET_SERVER;
 
+/** A piece of a logical packet written with my_net_write_pieces(). */
+struct st_net_piece
+{
+  const unsigned char *data;
+  size_t length;
+};
+
+typedef struct st_net_piece NET_PIECE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+my_bool my_net_write_pieces(struct st_net *net, const NET_PIECE *pieces,
+                            unsigned int count);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -107,6 +107,8 @@ struct st_mysql_options_extention {
   char *tls_version; /* TLS version option */
   long ssl_ctx_flags; /* SSL ctx options flag */
   unsigned int ssl_mode;
+  /* Level of LZ4 protocol compression, 0 to use zlib */
+  unsigned int compression_lz4_level;
 };
 
 typedef struct st_mysql_methods
@@ -146,6 +146,11 @@ my_bool vio_reset(Vio* vio, enum enum_vio_type type,
 size_t  vio_read(Vio *vio, uchar *	buf, size_t size);
 size_t  vio_read_buff(Vio *vio, uchar * buf, size_t size);
 size_t  vio_write(Vio *vio, const uchar * buf, size_t size);
+#ifndef _WIN32
+struct iovec;
+/* Gather write, for VIO_TYPE_TCPIP and VIO_TYPE_SOCKET connections only */
+size_t  vio_write_vector(Vio *vio, struct iovec *iov, int iovcnt);
+#endif
 /* setsockopt TCP_NODELAY at IPPROTO_TCP level, when possible */
 int vio_fastsend(Vio *vio);
 /* setsockopt SO_KEEPALIVE at SOL_SOCKET level, when possible */
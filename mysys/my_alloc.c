@@ -478,6 +478,67 @@ void free_root(MEM_ROOT *root, myf MyFlags)
 }
 
 
+/*
+  Free memory of a root, but keep some of its blocks for reuse
+
+  SYNOPSIS
+    trim_root()
+      root		Memory root
+      keep_size		Total size of blocks, besides the preallocated
+                        block, to keep in the root
+
+  DESCRIPTION
+    Works as free_root(root, MYF(MY_KEEP_PREALLOC)), except that up to
+    keep_size bytes of the other blocks are marked free and kept in the
+    root, so that the following allocations are served from them
+    instead of malloc. Blocks which don't fit into keep_size, e.g. the
+    large ones allocated for an exceptionally big statement, are freed.
+*/
+
+void trim_root(MEM_ROOT *root, size_t keep_size)
+{
+#if defined(PREALLOCATE_MEMORY_CHUNKS)
+  USED_MEM *next, **prev;
+  size_t kept= 0;
+  DBUG_ENTER("trim_root");
+  DBUG_PRINT("enter",("root: 0x%lx  keep_size: %lu", (long) root,
+                      (ulong) keep_size));
+
+  if (!keep_size)
+  {
+    free_root(root, MYF(MY_KEEP_PREALLOC));
+    DBUG_VOID_RETURN;
+  }
+
+  mark_blocks_free(root);
+
+  for (prev= &root->free; (next= *prev); )
+  {
+    if (next == root->pre_alloc || kept + next->size <= keep_size)
+    {
+      if (next != root->pre_alloc)
+        kept+= next->size;
+      prev= &next->next;
+    }
+    else
+    {
+      *prev= next->next;
+      root->allocated_size-= next->size;
+      next->left= next->size;
+      TRASH_MEM(next);
+      my_free(next);
+    }
+  }
+  root->block_num= 4;
+  DBUG_VOID_RETURN;
+#else
+  /* alloc_root() doesn't reuse free blocks without preallocation */
+  (void) keep_size;
+  free_root(root, MYF(MY_KEEP_PREALLOC));
+#endif
+}
+
+
 char *strdup_root(MEM_ROOT *root, const char *str)
 {
   return strmake_root(root, str, strlen(str));
@@ -3712,7 +3712,8 @@ cli_calculate_client_flag(MYSQL *mysql, const char *db, ulong client_flag)
 
   /* Remove options that server doesn't support */
   mysql->client_flag= mysql->client_flag &
-    (~(CLIENT_COMPRESS | CLIENT_SSL | CLIENT_PROTOCOL_41)
+    (~(CLIENT_COMPRESS | CLIENT_COMPRESS_LZ4 | CLIENT_SSL |
+       CLIENT_PROTOCOL_41 | CLIENT_STMT_PARAMETER_BATCH)
     | mysql->server_capabilities);
 
   if(mysql->options.protocol == MYSQL_PROTOCOL_SOCKET &&
@@ -3723,8 +3724,20 @@ cli_calculate_client_flag(MYSQL *mysql, const char *db, ulong client_flag)
     mysql->options.extension->ssl_mode= SSL_MODE_DISABLED;
   }
 #ifndef HAVE_COMPRESS
-  mysql->client_flag&= ~CLIENT_COMPRESS;
+  mysql->client_flag&= ~(CLIENT_COMPRESS | CLIENT_COMPRESS_LZ4);
 #endif
+  /*
+    Other servers give the bits of CLIENT_COMPRESS_LZ4 and
+    CLIENT_STMT_PARAMETER_BATCH other meanings: MariaDB, which reports a
+    5.5.5- version prefix, and MySQL 8.0.
+  */
+  if ((mysql->client_flag &
+       (CLIENT_COMPRESS_LZ4 | CLIENT_STMT_PARAMETER_BATCH)) &&
+      (mysql_get_server_version(mysql) < 50700 ||
+       mysql_get_server_version(mysql) >= 80000))
+    mysql->client_flag&= ~(CLIENT_COMPRESS_LZ4 | CLIENT_STMT_PARAMETER_BATCH);
+  if (!(mysql->client_flag & CLIENT_COMPRESS))
+    mysql->client_flag&= ~CLIENT_COMPRESS_LZ4;
 }
 
 
@@ -5032,7 +5045,22 @@ CLI_MYSQL_REAL_CONNECT(MYSQL *mysql,const char *host, const char *user,
   */
 
   if (mysql->client_flag & CLIENT_COMPRESS)      /* We will use compression */
+  {
     net->compress=1;
+#ifdef HAVE_COMPRESS
+    if ((mysql->client_flag & CLIENT_COMPRESS_LZ4) &&
+        my_net_set_compression_lz4(net, mysql->options.extension &&
+                                        mysql->options.extension->
+                                        compression_lz4_level ?
+                                        mysql->options.extension->
+                                        compression_lz4_level :
+                                        NET_COMPRESSION_DEFAULT_LEVEL))
+    {
+      set_mysql_error(mysql, CR_OUT_OF_MEMORY, unknown_sqlstate);
+      goto error;
+    }
+#endif
+  }
 
 #ifdef CHECK_LICENSE 
   if (check_license(mysql))
@@ -5881,6 +5909,18 @@ mysql_options(MYSQL *mysql,enum mysql_option option, const void *arg)
     g_net_buffer_length= (*(ulong *) arg);
     break;
 
+  case MYSQL_OPT_COMPRESSION_LZ4:
+    ENSURE_EXTENSIONS_PRESENT(&mysql->options);
+    mysql->options.extension->compression_lz4_level= *(uint *) arg;
+    if (mysql->options.extension->compression_lz4_level)
+    {
+      mysql->options.compress= 1;
+      mysql->options.client_flag|= CLIENT_COMPRESS | CLIENT_COMPRESS_LZ4;
+    }
+    else
+      mysql->options.client_flag&= ~CLIENT_COMPRESS_LZ4;
+    break;
+
   default:
     DBUG_RETURN(1);
   }
@@ -5899,7 +5939,7 @@ mysql_options(MYSQL *mysql,enum mysql_option option, const void *arg)
 
   uint
     MYSQL_OPT_CONNECT_TIMEOUT, MYSQL_OPT_READ_TIMEOUT, MYSQL_OPT_WRITE_TIMEOUT,
-    MYSQL_OPT_PROTOCOL, MYSQL_OPT_SSL_MODE
+    MYSQL_OPT_PROTOCOL, MYSQL_OPT_SSL_MODE, MYSQL_OPT_COMPRESSION_LZ4
 
   my_bool
     MYSQL_OPT_COMPRESS, MYSQL_OPT_LOCAL_INFILE, MYSQL_OPT_USE_REMOTE_CONNECTION,
@@ -6018,6 +6058,10 @@ mysql_get_option(MYSQL *mysql, enum mysql_option option, const void *arg)
     *((uint *) arg)= mysql->options.extension ?
                      mysql->options.extension->ssl_mode : 0;
     break;
+  case MYSQL_OPT_COMPRESSION_LZ4:
+    *((uint *) arg)= mysql->options.extension ?
+                     mysql->options.extension->compression_lz4_level : 0;
+    break;
   case MYSQL_PLUGIN_DIR:
     *((char **)arg)= mysql->options.extension ?
                      mysql->options.extension->plugin_dir : NULL;
@@ -545,6 +545,10 @@ static bool send_server_handshake_packet(MPVIO_EXT *mpvio,
     protocol->add_client_capability(CLIENT_TRANSACTIONS);
 
   protocol->add_client_capability(CAN_CLIENT_COMPRESS);
+#ifdef HAVE_COMPRESS
+  if (opt_protocol_compression_lz4)
+    protocol->add_client_capability(CLIENT_COMPRESS_LZ4);
+#endif
 
   if (ssl_acceptor_fd)
   {
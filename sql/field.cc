@@ -1728,7 +1728,12 @@ bool Field::send_text(Protocol *protocol)
     dbug_tmp_restore_column_map(table->read_set, old_map);
 #endif
 
-  return res ? protocol->store(res) : protocol->store_null();
+  if (!res)
+    return protocol->store_null();
+  /* A value pointing into the record stays there until the row is sent */
+  if (res == &str && !str.is_alloced() && str.ptr() != buff)
+    return protocol->store_stable(str.ptr(), str.length(), str.charset());
+  return protocol->store(res);
 }
 
 
@@ -1739,7 +1744,11 @@ bool Field::send_binary(Protocol *protocol)
   if (is_null())
     return protocol->store_null();
   String *res= val_str(&tmp);
-  return res ? protocol->store(res) : protocol->store_null();
+  if (!res)
+    return protocol->store_null();
+  if (res == &tmp && !tmp.is_alloced() && tmp.ptr() != buff)
+    return protocol->store_stable(tmp.ptr(), tmp.length(), tmp.charset());
+  return protocol->store(res);
 }
 
 /**
@@ -46,6 +46,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <lz4.h>
 using std::max;
 using std::min;
 
@@ -82,6 +83,9 @@ static ha_rows find_all_keys(Sort_param *param, QEP_TAB *qep_tab,
                              ha_rows *found_rows);
 static int write_keys(Sort_param *param, Filesort_info *fs_info,
                       uint count, IO_CACHE *buffer_file, IO_CACHE *tempfile);
+static int write_spill_record(Sort_param *param, IO_CACHE *to_file,
+                              const uchar *record, uint length);
+static int flush_spill_frame(Sort_param *param, IO_CACHE *to_file);
 static void register_used_fields(Sort_param *param);
 static int merge_index(Sort_param *param,
                        Sort_buffer sort_buffer,
@@ -204,6 +208,44 @@ static void trace_filesort_information(Opt_trace_context *trace,
 }
 
 
+static void trace_filesort_phase(Opt_trace_context *trace, const char *name,
+                                 ha_rows rows, ulonglong usecs)
+{
+  Opt_trace_object(trace, name)
+    .add("rows", rows)
+    .add("microseconds", usecs)
+    .add("rows_per_second", usecs ? rows * 1000000ULL / usecs : rows);
+}
+
+
+/**
+  Write the time spent in each phase of filesort, and the rate at which
+  rows went through it, to the optimizer trace.
+
+  @param trace       Optimizer trace.
+  @param param       Sort parameters, with the time spent sorting buffers.
+  @param num_rows    Number of sorted rows.
+  @param scan_time   Microseconds spent reading rows and making keys.
+  @param merge_time  Microseconds spent merging chunks, 0 if in memory.
+*/
+
+static void trace_filesort_phases(Opt_trace_context *trace,
+                                  const Sort_param *param, ha_rows num_rows,
+                                  ulonglong scan_time, ulonglong merge_time)
+{
+  if (!trace->is_started())
+    return;
+
+  Opt_trace_object trace_phases(trace, "filesort_phases");
+  trace_phases.add("sort_threads", param->sort_threads);
+  trace_filesort_phase(trace, "key_generation", param->examined_rows,
+                       scan_time);
+  trace_filesort_phase(trace, "buffer_sort", num_rows, param->sort_time);
+  if (merge_time)
+    trace_filesort_phase(trace, "merge", num_rows, merge_time);
+}
+
+
 /**
   Sort a table.
   Creates a set of pointers that can be used to read the rows
@@ -258,6 +300,8 @@ bool filesort(THD *thd, Filesort *filesort, bool sort_positions,
   TABLE *const table= tab->table();
   ha_rows max_rows= filesort->limit;
   uint s_length= 0;
+  ulonglong scan_time= 0;
+  ulonglong merge_time= 0;
 
   DBUG_ENTER("filesort");
 
@@ -414,9 +458,19 @@ bool filesort(THD *thd, Filesort *filesort, bool sort_positions,
   param.sort_form= table;
   param.local_sortorder=
     Bounds_checked_array<st_sort_field>(filesort->sortorder, s_length);
+  param.sort_threads= thd->variables.sort_threads;
+  /*
+    Every chunk of a merge must be able to hold a whole frame, and
+    merge_buffers() merges up to MERGEBUFF2 chunks.
+  */
+  if (thd->variables.sort_spill_compression && !param.using_pq)
+    param.spill_frame_max_records=
+      min(param.max_keys_per_buffer / MERGEBUFF2,
+          max(1U, SPILL_FRAME_SIZE / param.rec_length));
   // New scope, because subquery execution must be traced within an array.
   {
     Opt_trace_array ota(trace, "filesort_execution");
+    scan_time= my_micro_time();
     num_rows= find_all_keys(&param, tab,
                             &table_sort,
                             &chunk_file,
@@ -425,6 +479,7 @@ bool filesort(THD *thd, Filesort *filesort, bool sort_positions,
                             found_rows);
     if (num_rows == HA_POS_ERROR)
       goto err;
+    scan_time= my_micro_time() - scan_time - param.sort_time;
   }
 
   num_chunks= static_cast<size_t>(my_b_tell(&chunk_file)) /
@@ -476,6 +531,7 @@ bool filesort(THD *thd, Filesort *filesort, bool sort_positions,
     param.max_keys_per_buffer=
       table_sort.sort_buffer_size() / param.rec_length;
 
+    merge_time= my_micro_time();
     if (merge_many_buff(&param,
                         table_sort.get_raw_buf(),
                         table_sort.merge_chunks,
@@ -492,8 +548,12 @@ bool filesort(THD *thd, Filesort *filesort, bool sort_positions,
                     &tempfile,
                     outfile))
       goto err;
+    merge_time= my_micro_time() - merge_time;
   }
 
+  if (param.sort_threads > 1)
+    trace_filesort_phases(trace, &param, num_rows, scan_time, merge_time);
+
   if (num_rows > param.max_rows)
   {
     // If find_all_keys() produced more results than the query LIMIT.
@@ -503,6 +563,9 @@ bool filesort(THD *thd, Filesort *filesort, bool sort_positions,
 
  err:
   my_free(param.tmp_buffer);
+  my_free(param.spill_frame);
+  thd->sort_spill_bytes+= param.spill_bytes;
+  thd->sort_spill_disk_bytes+= param.spill_disk_bytes;
   if (!subselect || !subselect->is_uncacheable())
   {
     if (!table_sort.sorted_result_in_fsbuf)
@@ -1124,7 +1187,9 @@ write_keys(Sort_param *param, Filesort_info *fs_info, uint count,
   Merge_chunk merge_chunk;
   DBUG_ENTER("write_keys");
 
+  const ulonglong sort_start= my_micro_time();
   fs_info->sort_buffer(param, count);
+  param->sort_time+= my_micro_time() - sort_start;
 
   if (!my_b_inited(tempfile) &&
       open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX, DISK_BUFFER_SIZE,
@@ -1156,9 +1221,11 @@ write_keys(Sort_param *param, Filesort_info *fs_info, uint count,
     else
       rec_length= param->rec_length;
 
-    if (my_b_write(tempfile, record, rec_length))
+    if (write_spill_record(param, tempfile, record, rec_length))
       DBUG_RETURN(1);                           /* purecov: inspected */
   }
+  if (flush_spill_frame(param, tempfile))
+    DBUG_RETURN(1);                             /* purecov: inspected */
 
   if (my_b_write(chunk_file, &merge_chunk, sizeof(merge_chunk)))
     DBUG_RETURN(1);                             /* purecov: inspected */
@@ -1167,6 +1234,102 @@ write_keys(Sort_param *param, Filesort_info *fs_info, uint count,
 } /* write_keys */
 
 
+/**
+  Write a record of a chunk to a spill file.
+
+  Unless param->spill_frame_max_records is 0, the records are gathered
+  into a frame which is written LZ4 compressed by flush_spill_frame().
+  A frame holds whole records only, and no more of them than any chunk
+  buffer of merge_buffers() can take, so that read_to_buffer() can always
+  decompress a frame straight into the chunk buffer.
+
+  @param param    Sort parameters.
+  @param to_file  Spill file being written.
+  @param record   Record to write.
+  @param length   Length of the record.
+
+  @returns
+    0 OK
+  @returns
+    1 Error
+*/
+
+static int write_spill_record(Sort_param *param, IO_CACHE *to_file,
+                              const uchar *record, uint length)
+{
+  param->spill_bytes+= length;
+  if (param->spill_frame_max_records == 0)
+  {
+    param->spill_disk_bytes+= length;
+    return my_b_write(to_file, record, length);
+  }
+
+  if (param->spill_frame == NULL)
+  {
+    const size_t frame_size= param->spill_frame_max_records *
+                             static_cast<size_t>(param->rec_length);
+    const size_t compressed_size= SPILL_FRAME_HEADER_SIZE +
+                                  LZ4_COMPRESSBOUND(frame_size);
+    if (!(param->spill_frame=
+          static_cast<uchar*>(my_malloc(key_memory_Sort_param_tmp_buffer,
+                                        frame_size + compressed_size,
+                                        MYF(MY_WME)))))
+      return 1;                                 /* purecov: inspected */
+    param->spill_compressed= param->spill_frame + frame_size;
+    param->spill_frame_end= param->spill_frame;
+    param->spill_frame_records= 0;
+  }
+  else if (param->spill_frame_records == param->spill_frame_max_records &&
+           flush_spill_frame(param, to_file))
+    return 1;                                   /* purecov: inspected */
+
+  memcpy(param->spill_frame_end, record, length);
+  param->spill_frame_end+= length;
+  param->spill_frame_records++;
+  return 0;
+}
+
+
+/**
+  Compress the records gathered by write_spill_record() and write them to
+  the spill file as one frame: the compressed length, the uncompressed
+  length and the number of records, followed by the compressed records.
+
+  @returns
+    0 OK
+  @returns
+    1 Error
+*/
+
+static int flush_spill_frame(Sort_param *param, IO_CACHE *to_file)
+{
+  if (param->spill_frame == NULL || param->spill_frame_records == 0)
+    return 0;
+
+  const int length= static_cast<int>(param->spill_frame_end -
+                                     param->spill_frame);
+  const int compressed_length=
+    LZ4_compress_default(pointer_cast<const char*>(param->spill_frame),
+                         pointer_cast<char*>(param->spill_compressed +
+                                             SPILL_FRAME_HEADER_SIZE),
+                         length, LZ4_COMPRESSBOUND(length));
+  if (compressed_length <= 0)
+    return 1;                                   /* purecov: inspected */
+
+  int4store(param->spill_compressed, compressed_length);
+  int4store(param->spill_compressed + 4, length);
+  int4store(param->spill_compressed + 8, param->spill_frame_records);
+  const size_t frame_length= SPILL_FRAME_HEADER_SIZE + compressed_length;
+  if (my_b_write(to_file, param->spill_compressed, frame_length))
+    return 1;                                   /* purecov: inspected */
+
+  param->spill_disk_bytes+= frame_length;
+  param->spill_frame_end= param->spill_frame;
+  param->spill_frame_records= 0;
+  return 0;
+}
+
+
 /**
   Store length as suffix in high-byte-first order.
 */
@@ -1632,7 +1795,9 @@ static bool save_index(Sort_param *param, uint count, Filesort_info *table_sort)
   uchar *to;
   DBUG_ENTER("save_index");
 
+  const ulonglong sort_start= my_micro_time();
   table_sort->sort_buffer(param, count);
+  param->sort_time+= my_micro_time() - sort_start;
 
   if (param->using_addon_fields())
   {
@@ -1908,6 +2073,74 @@ cleanup:
 } /* merge_many_buff */
 
 
+/**
+  Read whole LZ4 compressed frames of a chunk to the chunk buffer, as many
+  as fit. See write_spill_record().
+
+  @returns
+    (uint)-1 if something goes wrong
+*/
+
+static uint read_frames_to_buffer(IO_CACHE *fromfile,
+                                  Merge_chunk *merge_chunk,
+                                  Sort_param *param)
+{
+  DBUG_ENTER("read_frames_to_buffer");
+  uchar *to= merge_chunk->buffer_start();
+  ha_rows count= 0;
+
+  while (merge_chunk->rowcount() > 0)
+  {
+    uchar *header= param->spill_compressed;
+    if (mysql_file_pread(fromfile->file, header, SPILL_FRAME_HEADER_SIZE,
+                         merge_chunk->file_position(), MYF_RW))
+      DBUG_RETURN((uint) -1);                   /* purecov: inspected */
+    const uint compressed_length= uint4korr(header);
+    const uint length= uint4korr(header + 4);
+    const uint records= uint4korr(header + 8);
+    if (count + records > merge_chunk->max_keys() ||
+        to + length > merge_chunk->buffer_end())
+    {
+      // write_spill_record() makes sure a frame fits in an empty buffer.
+      DBUG_ASSERT(count > 0);
+      if (count == 0)
+        DBUG_RETURN((uint) -1);                 /* purecov: inspected */
+      break;
+    }
+
+    const my_off_t data_pos=
+      merge_chunk->file_position() + SPILL_FRAME_HEADER_SIZE;
+    if (mysql_file_pread(fromfile->file,
+                         param->spill_compressed + SPILL_FRAME_HEADER_SIZE,
+                         compressed_length, data_pos, MYF_RW))
+      DBUG_RETURN((uint) -1);                   /* purecov: inspected */
+#ifdef POSIX_FADV_DONTNEED
+    /* Each frame is read exactly once.  Free up the file cache. */
+    posix_fadvise(fromfile->file, merge_chunk->file_position(),
+                  SPILL_FRAME_HEADER_SIZE + compressed_length,
+                  POSIX_FADV_DONTNEED);
+#endif /* POSIX_FADV_DONTNEED */
+
+    if (LZ4_decompress_safe(pointer_cast<const char*>(param->spill_compressed +
+                                                      SPILL_FRAME_HEADER_SIZE),
+                            pointer_cast<char*>(to),
+                            compressed_length, length) !=
+        static_cast<int>(length))
+      DBUG_RETURN((uint) -1);                   /* purecov: inspected */
+
+    to+= length;
+    count+= records;
+    merge_chunk->advance_file_position(SPILL_FRAME_HEADER_SIZE +
+                                       compressed_length);
+    merge_chunk->decrement_rowcount(records);
+  }
+
+  merge_chunk->init_current_key();
+  merge_chunk->set_mem_count(count);
+  DBUG_RETURN(static_cast<uint>(to - merge_chunk->buffer_start()));
+}
+
+
 /**
   Read data to buffer.
 
@@ -1923,6 +2156,9 @@ uint read_to_buffer(IO_CACHE *fromfile,
   uint rec_length= param->rec_length;
   ha_rows count;
 
+  if (param->spill_frame_max_records)
+    DBUG_RETURN(read_frames_to_buffer(fromfile, merge_chunk, param));
+
   if ((count= min(merge_chunk->max_keys(), merge_chunk->rowcount())))
   {
     size_t bytes_to_read;
@@ -1979,6 +2215,12 @@ uint read_to_buffer(IO_CACHE *fromfile,
     else
       num_bytes_read= bytes_to_read;
 
+#ifdef POSIX_FADV_DONTNEED
+    /* Each record is read exactly once.  Free up the file cache. */
+    posix_fadvise(fromfile->file, merge_chunk->file_position(),
+                  num_bytes_read, POSIX_FADV_DONTNEED);
+#endif /* POSIX_FADV_DONTNEED */
+
     merge_chunk->init_current_key();
     merge_chunk->advance_file_position(num_bytes_read);
     merge_chunk->decrement_rowcount(count);
@@ -2184,7 +2426,10 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
 
         DBUG_PRINT("info", ("write record at %llu len %u",
                             my_b_tell(to_file), bytes_to_write));
-        if (my_b_write(to_file,
+        if (flag == 0 ?
+            write_spill_record(param, to_file,
+                               merge_chunk->current_key(), bytes_to_write) :
+            my_b_write(to_file,
                        merge_chunk->current_key() + offset, bytes_to_write))
         {
           DBUG_RETURN(1);                     /* purecov: inspected */
@@ -2250,7 +2495,10 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
       param->get_rec_and_res_len(merge_chunk->current_key(),
                                  &rec_length, &res_length);
       const uint bytes_to_write= (flag == 0) ? rec_length : res_length;
-      if (my_b_write(to_file,
+      if (flag == 0 ?
+          write_spill_record(param, to_file,
+                             merge_chunk->current_key(), bytes_to_write) :
+          my_b_write(to_file,
                      merge_chunk->current_key() + offset,
                      bytes_to_write))
       {
@@ -2263,6 +2511,8 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
          != -1 && error != 0);
 
 end:
+  if (error == 0 && flag == 0 && flush_spill_frame(param, to_file))
+    error= 1;                                   /* purecov: inspected */
   last_chunk->set_rowcount(min(org_max_rows-max_rows, param->max_rows));
   last_chunk->set_file_position(to_start_filepos);
 
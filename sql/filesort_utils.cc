@@ -215,6 +215,202 @@ size_t try_reserve(std::pair<type*, ptrdiff_t> *buf, ptrdiff_t size)
   return buf->second;
 }
 
+
+/// Minimum number of keys for each thread of a parallel sort.
+const uint PARALLEL_SORT_MIN_KEYS= 10000;
+
+/// Keys up to this long are sorted with radix_sort_keys().
+const size_t RADIX_SORT_MAX_KEY_LENGTH= 20;
+
+/// Minimum number of keys for radix_sort_keys() to beat a comparison sort.
+const size_t RADIX_SORT_MIN_KEYS= 1000;
+
+/// radix_sort_keys() sorts buckets smaller than this by insertion.
+const size_t RADIX_SORT_MIN_BUCKET= 32;
+
+/// Number of leading key bytes that prefix_sort_keys() compares as integers.
+const size_t KEY_PREFIX_LENGTH= 8;
+
+
+/**
+  Sorts the key pointers in [first, last), choosing the algorithm and the
+  comparator the same way as the single-threaded Filesort_buffer::sort_buffer().
+
+  @param first        First key pointer.
+  @param last         End of the key pointers.
+  @param sort_length  Length of the keys.
+  @param scratch      Scratch array for (last - first) pointers, or NULL.
+ */
+void sort_key_range(uchar **first, uchar **last, size_t sort_length,
+                    uchar **scratch)
+{
+  const size_t count= last - first;
+  /*
+    std::stable_sort has some extra overhead in allocating the temp buffer,
+    which takes some time. The cutover point where it starts to get faster
+    than quicksort seems to be somewhere around 10 to 40 records.
+    So we're a bit conservative, and stay with quicksort up to 100 records.
+  */
+  if (count <= 100)
+  {
+    if (sort_length < 10)
+      std::sort(first, last, Mem_compare(sort_length));
+    else
+      std::sort(first, last, Mem_compare_longkey(sort_length));
+    return;
+  }
+  /*
+    Short keys: a few passes over the key bytes are cheaper than
+    n * log(n) comparisons.
+  */
+  if (scratch != NULL && sort_length <= RADIX_SORT_MAX_KEY_LENGTH &&
+      count >= RADIX_SORT_MIN_KEYS)
+  {
+    radix_sort_keys(first, count, sort_length, scratch);
+    return;
+  }
+  /*
+    Long keys: most comparisons are decided by the first bytes, so
+    compare those without following the key pointers.
+  */
+  if (sort_length >= 10 && prefix_sort_keys(first, count, sort_length))
+    return;
+  // Heuristics here: avoid function overhead call for short keys.
+  if (sort_length < 10)
+    std::stable_sort(first, last, Mem_compare(sort_length));
+  else
+    std::stable_sort(first, last, Mem_compare_longkey(sort_length));
+}
+
+
+/**
+  Merges the sorted key pointers [first, middle) and [middle, last) into
+  'to'. Keys from the first range go first when equal, so that merging
+  stable sorted ranges gives a stable result.
+ */
+void merge_key_ranges(uchar **first, uchar **middle, uchar **last,
+                      uchar **to, size_t sort_length)
+{
+  if (sort_length < 10)
+    std::merge(first, middle, middle, last, to, Mem_compare(sort_length));
+  else
+    std::merge(first, middle, middle, last, to,
+               Mem_compare_longkey(sort_length));
+}
+
+
+/**
+  One unit of work of a parallel sort: either sort [first, last) in place,
+  using 'middle' as scratch space, or, if 'to' is set, merge
+  [first, middle) and [middle, last) into 'to'.
+ */
+struct Sort_task
+{
+  uchar **first;
+  uchar **middle;
+  uchar **last;
+  uchar **to;
+  size_t sort_length;
+
+  void run() const
+  {
+    if (to == NULL)
+      sort_key_range(first, last, sort_length, middle);
+    else if (middle == last)
+      std::copy(first, last, to);
+    else
+      merge_key_ranges(first, middle, last, to, sort_length);
+  }
+};
+
+
+extern "C" void *sort_task_thread(void *arg)
+{
+  static_cast<Sort_task*>(arg)->run();
+  return NULL;
+}
+
+
+/**
+  Runs the tasks concurrently, one of them in the calling thread. A task
+  whose thread cannot be created is run in the calling thread instead.
+ */
+void run_sort_tasks(Sort_task *tasks, uint num_tasks)
+{
+  std::vector<my_thread_handle> handles(num_tasks);
+  std::vector<bool> started(num_tasks, false);
+  my_thread_attr_t attr;
+  my_thread_attr_init(&attr);
+  my_thread_attr_setdetachstate(&attr, MY_THREAD_CREATE_JOINABLE);
+
+  for (uint i= 1; i < num_tasks; ++i)
+    started[i]= my_thread_create(&handles[i], &attr, sort_task_thread,
+                                 &tasks[i]) == 0;
+  my_thread_attr_destroy(&attr);
+
+  tasks[0].run();
+  for (uint i= 1; i < num_tasks; ++i)
+  {
+    if (started[i])
+      my_thread_join(&handles[i], NULL);
+    else
+      tasks[i].run();
+  }
+}
+
+
+/**
+  Sorts the key pointers with several threads: the array is split into
+  num_threads ranges which are sorted concurrently, and the sorted ranges
+  are then merged pairwise, each round of merges also running concurrently.
+
+  @param keys         Array of pointers to the keys.
+  @param count        Number of keys.
+  @param sort_length  Length of the keys.
+  @param num_threads  Number of threads to sort with, at least 2.
+  @param buffer       Scratch array for 'count' pointers.
+ */
+void parallel_sort_keys(uchar **keys, uint count, size_t sort_length,
+                        uint num_threads, uchar **buffer)
+{
+  std::vector<Sort_task> tasks(num_threads);
+  std::vector<uint> bounds(num_threads + 1);
+  for (uint i= 0; i <= num_threads; ++i)
+    bounds[i]= static_cast<uint>(static_cast<ulonglong>(count) * i /
+                                 num_threads);
+
+  for (uint i= 0; i < num_threads; ++i)
+  {
+    Sort_task task= { keys + bounds[i], buffer + bounds[i],
+                      keys + bounds[i + 1], NULL, sort_length };
+    tasks[i]= task;
+  }
+  run_sort_tasks(&tasks[0], num_threads);
+
+  uchar **from= keys;
+  uchar **to= buffer;
+  for (uint num_ranges= num_threads; num_ranges > 1;
+       num_ranges= (num_ranges + 1) / 2)
+  {
+    uint num_tasks= 0;
+    for (uint i= 0; i < num_ranges; i+= 2)
+    {
+      const uint end= bounds[std::min(i + 2, num_ranges)];
+      const uint middle= bounds[std::min(i + 1, num_ranges)];
+      Sort_task task= { from + bounds[i], from + middle, from + end,
+                        to + bounds[i], sort_length };
+      tasks[num_tasks]= task;
+      bounds[num_tasks++]= bounds[i];
+    }
+    bounds[num_tasks]= count;
+    run_sort_tasks(&tasks[0], num_tasks);
+    std::swap(from, to);
+  }
+
+  if (from != keys)
+    std::copy(from, from + count, keys);
+}
+
 } // namespace
 
 void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
@@ -231,39 +427,171 @@ void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
   {
     reverse_record_pointers();
   }
-  std::pair<uchar**, ptrdiff_t> buffer;
-  if (radixsort_is_appliccable(count, param->sort_length) &&
-      try_reserve(&buffer, count))
-  {
-    radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer.first);
-    std::return_temporary_buffer(buffer.first);
-    return;
-  }
   /*
-    std::stable_sort has some extra overhead in allocating the temp buffer,
-    which takes some time. The cutover point where it starts to get faster
-    than quicksort seems to be somewhere around 10 to 40 records.
-    So we're a bit conservative, and stay with quicksort up to 100 records.
+    Scratch space for the radix sort and the parallel merges. Without it
+    we fall back to comparison sorts on a single thread.
   */
-  if (count <= 100)
+  std::pair<uchar**, ptrdiff_t> buffer(NULL, 0);
+  if (count > 100 && !try_reserve(&buffer, count))
+    buffer.first= NULL;
+
+  /*
+    Give every thread enough keys to make up for the cost of creating it.
+  */
+  const uint num_threads= std::min<uint>(param->sort_threads,
+                                         count / PARALLEL_SORT_MIN_KEYS);
+  if (num_threads > 1 && buffer.first != NULL)
+    parallel_sort_keys(m_sort_keys, count, param->sort_length, num_threads,
+                       buffer.first);
+  else
+    sort_key_range(m_sort_keys, m_sort_keys + count, param->sort_length,
+                   buffer.first);
+
+  if (buffer.first != NULL)
+    std::return_temporary_buffer(buffer.first);
+}
+
+
+namespace {
+
+/**
+  Compares keys from the given offset on. Used by radix_sort_keys() for
+  the buckets in which all keys share the bytes before the offset.
+ */
+inline bool key_suffix_less(const uchar *s1, const uchar *s2,
+                            size_t offset, size_t key_length)
+{
+  return memcmp(s1 + offset, s2 + offset, key_length - offset) < 0;
+}
+
+/**
+  A bucket of radix_sort_keys(): 'count' keys starting at 'start' which
+  share the first 'depth' bytes.
+ */
+struct Radix_bucket
+{
+  size_t start;
+  size_t count;
+  size_t depth;
+};
+
+
+/// A key pointer together with the leading bytes of the key.
+struct Key_prefix
+{
+  ulonglong prefix;
+  uchar *key;
+};
+
+/**
+  Orders Key_prefix elements by their prefix, and by the rest of the keys
+  when the prefixes are equal.
+ */
+class Key_prefix_less
+{
+public:
+  Key_prefix_less(size_t key_length)
+    : m_suffix_length(key_length - KEY_PREFIX_LENGTH)
+  {}
+  bool operator()(const Key_prefix &k1, const Key_prefix &k2) const
   {
-    if (param->sort_length < 10)
+    if (k1.prefix != k2.prefix)
+      return k1.prefix < k2.prefix;
+    return memcmp(k1.key + KEY_PREFIX_LENGTH, k2.key + KEY_PREFIX_LENGTH,
+                  m_suffix_length) < 0;
+  }
+private:
+  size_t m_suffix_length;
+};
+
+} // namespace
+
+
+void radix_sort_keys(uchar **keys, size_t count, size_t key_length,
+                     uchar **scratch)
+{
+  size_t histogram[256];
+  std::vector<Radix_bucket> stack;
+  Radix_bucket all= { 0, count, 0 };
+  stack.push_back(all);
+
+  while (!stack.empty())
+  {
+    Radix_bucket bucket= stack.back();
+    stack.pop_back();
+    uchar **first= keys + bucket.start;
+
+    if (bucket.count < RADIX_SORT_MIN_BUCKET)
     {
-      std::sort(m_sort_keys, m_sort_keys + count,
-                Mem_compare(param->sort_length));
-      return;
+      // Insertion sort, which keeps equal keys in order.
+      for (size_t i= 1; i < bucket.count; ++i)
+      {
+        uchar *key= first[i];
+        size_t j= i;
+        for (; j > 0 &&
+               key_suffix_less(key, first[j - 1], bucket.depth, key_length);
+             --j)
+          first[j]= first[j - 1];
+        first[j]= key;
+      }
+      continue;
     }
-    std::sort(m_sort_keys, m_sort_keys + count,
-              Mem_compare_longkey(param->sort_length));
-    return;
+
+    // Skip the bytes which all keys of the bucket have in common.
+    for (; bucket.depth < key_length; ++bucket.depth)
+    {
+      memset(histogram, 0, sizeof(histogram));
+      for (size_t i= 0; i < bucket.count; ++i)
+        histogram[first[i][bucket.depth]]++;
+      if (histogram[first[0][bucket.depth]] != bucket.count)
+        break;
+    }
+    if (bucket.depth == key_length)
+      continue;                                 // All keys are equal.
+
+    // Distribute the keys on the byte at 'depth', keeping their order.
+    uchar **to= scratch + bucket.start;
+    size_t offset= 0;
+    for (uint byte= 0; byte < 256; ++byte)
+    {
+      const size_t bucket_count= histogram[byte];
+      if (bucket_count > 1)
+      {
+        Radix_bucket next= { bucket.start + offset, bucket_count,
+                             bucket.depth + 1 };
+        stack.push_back(next);
+      }
+      histogram[byte]= offset;
+      offset+= bucket_count;
+    }
+    for (size_t i= 0; i < bucket.count; ++i)
+      to[histogram[first[i][bucket.depth]]++]= first[i];
+    memcpy(first, to, bucket.count * sizeof(uchar*));
   }
-  // Heuristics here: avoid function overhead call for short keys.
-  if (param->sort_length < 10)
+}
+
+
+bool prefix_sort_keys(uchar **keys, size_t count, size_t key_length)
+{
+  DBUG_ASSERT(key_length > KEY_PREFIX_LENGTH);
+  std::pair<Key_prefix*, ptrdiff_t> prefixes;
+  if (!try_reserve(&prefixes, count))
+    return false;
+
+  for (size_t i= 0; i < count; ++i)
   {
-    std::stable_sort(m_sort_keys, m_sort_keys + count,
-                     Mem_compare(param->sort_length));
-    return;
+    const uchar *key= keys[i];
+    ulonglong prefix= 0;
+    for (size_t j= 0; j < KEY_PREFIX_LENGTH; ++j)
+      prefix= (prefix << 8) | key[j];
+    prefixes.first[i].prefix= prefix;
+    prefixes.first[i].key= keys[i];
   }
-  std::stable_sort(m_sort_keys, m_sort_keys + count,
-                   Mem_compare_longkey(param->sort_length));
+  std::stable_sort(prefixes.first, prefixes.first + count,
+                   Key_prefix_less(key_length));
+  for (size_t i= 0; i < count; ++i)
+    keys[i]= prefixes.first[i].key;
+
+  std::return_temporary_buffer(prefixes.first);
+  return true;
 }
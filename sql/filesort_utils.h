@@ -52,6 +52,43 @@ double get_merge_many_buffs_cost_fast(ha_rows num_rows,
                                       const Cost_model_table *cost_model);
 
 
+/**
+  Sort pointers to fixed-length keys, which compare with memcmp(), with a
+  most-significant-byte-first radix sort. Equal keys keep their order.
+
+  @param keys        Array of pointers to the keys.
+  @param count       Number of keys.
+  @param key_length  Length of the keys.
+  @param scratch     Scratch array for 'count' pointers.
+
+  @note
+    Declared here in order to be able to unit test it.
+*/
+
+void radix_sort_keys(uchar **keys, size_t count, size_t key_length,
+                     uchar **scratch);
+
+
+/**
+  Sort pointers to fixed-length keys, which compare with memcmp(), as
+  (prefix, pointer) pairs: the first bytes of every key are copied next to
+  its pointer, so that most comparisons do not follow the pointers.
+  Equal keys keep their order.
+
+  @param keys        Array of pointers to the keys.
+  @param count       Number of keys.
+  @param key_length  Length of the keys, more than 8 bytes.
+
+  @returns
+    false if there was no memory for the pairs, and the keys are unsorted.
+
+  @note
+    Declared here in order to be able to unit test it.
+*/
+
+bool prefix_sort_keys(uchar **keys, size_t count, size_t key_length);
+
+
 /**
   A wrapper class around the buffer used by filesort().
   The sort buffer is a contiguous chunk of memory,
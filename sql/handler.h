@@ -681,6 +681,7 @@ enum enum_schema_tables
   SCH_TABLE_PRIVILEGES,
   SCH_TABLE_STATS,
   SCH_TEMPORARY_TABLES,
+  SCH_THREAD_POOL_GROUPS,
   SCH_THREAD_STATS,
   SCH_TRIGGERS,
   SCH_USER_PRIVILEGES,
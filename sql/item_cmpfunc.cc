@@ -1528,6 +1528,33 @@ int Arg_comparator::compare_datetime()
 }
 
 
+/**
+  Whether the values are compared as integers by compare_int_signed() or
+  one of its variants for the signedness of the arguments.
+*/
+
+bool Arg_comparator::compares_as_int() const
+{
+  return func == &Arg_comparator::compare_int_signed ||
+         func == &Arg_comparator::compare_int_signed_unsigned ||
+         func == &Arg_comparator::compare_int_unsigned_signed ||
+         func == &Arg_comparator::compare_int_unsigned;
+}
+
+
+/**
+  Whether the values are compared by compare_datetime() as DATETIME
+  values obtained with get_datetime_value().
+*/
+
+bool Arg_comparator::compares_as_datetime() const
+{
+  return func == &Arg_comparator::compare_datetime &&
+         get_value_a_func == &get_datetime_value &&
+         get_value_b_func == &get_datetime_value;
+}
+
+
 /**
   Get one of the arguments to the comparator as a JSON value.
 
@@ -114,6 +114,15 @@ public:
   int compare_datetime();        // compare args[0] & args[1] as DATETIMEs
   int compare_json();
 
+  /** The items compared, constants possibly replaced by converted values */
+  Item **left() const { return a; }
+  Item **right() const { return b; }
+  /** Whether the argument is a constant cached by the comparator */
+  bool is_cached_const(Item **arg) const
+  { return arg == &a_cache || arg == &b_cache; }
+  bool compares_as_int() const;
+  bool compares_as_datetime() const;
+
   static bool can_compare_as_dates(Item *a, Item *b, ulonglong *const_val_arg);
 
   Item** cache_converted_constant(THD *thd, Item **value, Item **cache,
@@ -467,6 +476,7 @@ public:
   bool is_null() { return MY_TEST(args[0]->is_null() || args[1]->is_null()); }
   const CHARSET_INFO *compare_collation()
   { return cmp.cmp_collation.collation; }
+  const Arg_comparator *get_comparator() const { return &cmp; }
   void top_level_item() { abort_on_null= TRUE; }
   void cleanup()
   {
@@ -885,11 +885,11 @@ bool Aggregator_distinct::setup(THD *thd)
     if (table->hash_field)
       table->file->ha_index_init(0, 0);
 
-    if (table->s->db_type() == heap_hton)
+    if (table->s->db_type() == heap_hton && !table->s->blob_fields)
     {
       /*
-        No blobs, otherwise it would have been MyISAM: set up a compare
-        function and its arguments to use with Unique.
+        No blobs: set up a compare function and its arguments to use with
+        Unique.
       */
       qsort_cmp2 compare_key;
       void* cmp_arg;
@@ -1113,7 +1113,16 @@ bool Aggregator_distinct::add()
       return false;
     if ((error= table->file->ha_write_row(table->record[0])) &&
         !table->file->is_ignorable_error(error))
-      return TRUE;
+    {
+      /* A heap table with blobs may get full */
+      if (create_ondisk_from_heap(current_thd, table,
+                                  tmp_table_param->start_recinfo,
+                                  &tmp_table_param->recinfo,
+                                  error, TRUE, NULL))
+        return TRUE;
+      if (table->hash_field && table->file->ha_index_init(0, false))
+        return TRUE;
+    }
     return FALSE;
   }
   else
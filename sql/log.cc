@@ -951,6 +951,21 @@ bool File_query_log::write_slow(THD *thd, ulonglong current_utime,
                   thd->query_plan_fsort_passes) == (uint) -1)
     goto err;
 
+  if ((thd->variables.log_slow_verbosity & (1ULL << SLOG_V_QUERY_PLAN)) &&
+      thd->sort_spill_bytes)
+  {
+    char buf[20];
+    snprintf(buf, 20, "%.2f", thd->sort_spill_disk_bytes ?
+             (double) thd->sort_spill_bytes / thd->sort_spill_disk_bytes :
+             1.0);
+    if (my_b_printf(&log_file,
+                    "# Sort_spill_bytes: %llu  Sort_spill_disk_bytes: %llu  "
+                    "Sort_spill_compression_ratio: %s\n",
+                    thd->sort_spill_bytes, thd->sort_spill_disk_bytes,
+                    buf) == (uint) -1)
+      goto err;
+  }
+
   if ((thd->variables.log_slow_verbosity & (1ULL << SLOG_V_INNODB))
       && thd->innodb_was_used)
   {
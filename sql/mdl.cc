@@ -209,6 +209,15 @@ public:
     return m_unused_lock_objects;
   }
 
+  /**
+    Get number of MDL_lock objects marked as destroyed so far. Objects
+    cached by MDL_context are valid only while it doesn't change.
+  */
+  int32 get_destroyed_locks_count()
+  {
+    return my_atomic_load32(&m_destroyed_lock_objects);
+  }
+
   /**
     Allocate pins which are necessary for MDL_context/thread to be able
     to work with MDL_map container.
@@ -251,6 +260,12 @@ private:
     this into account.
   */
   volatile int32 m_unused_lock_objects;
+  /**
+    Number of MDL_lock objects marked as destroyed since the start. It is
+    incremented before a destroyed object is removed from the hash, and
+    so before it can be freed and reused for another key.
+  */
+  volatile int32 m_destroyed_lock_objects;
   /** Pre-allocated MDL_lock object for BACKUP namespace. */
   MDL_lock *m_backup_lock;
   /** Pre-allocated MDL_lock object for BINLOG namespace */
@@ -1170,6 +1185,7 @@ void MDL_map::init()
   m_binlog_lock= MDL_lock::create(&binlog_lock_key);
 
   m_unused_lock_objects= 0;
+  m_destroyed_lock_objects= 0;
 
   lf_hash_init2(&m_locks, sizeof(MDL_lock), LF_HASH_UNIQUE,
                 0, 0, mdl_locks_key, &my_charset_bin, &murmur3_adapter,
@@ -1423,6 +1439,9 @@ void MDL_map::remove_random_unused(MDL_context *ctx, LF_PINS *pins,
     */
     mysql_prlock_unlock(&lock->m_rwlock);
 
+    /* Invalidate objects cached by contexts, @sa find_cached_lock(). */
+    my_atomic_add32(&m_destroyed_lock_objects, 1);
+
     DEBUG_SYNC(ctx->get_thd(), "mdl_remove_random_unused_after_is_destroyed_set");
 
     /*
@@ -1492,9 +1511,13 @@ MDL_context::MDL_context()
   m_force_dml_deadlock_weight(false),
   m_waiting_for(NULL),
   m_pins(NULL),
-  m_rand_state(UINT_MAX32)
+  m_rand_state(UINT_MAX32),
+  m_lock_cache_version(0),
+  m_lock_cache_victim(0)
 {
   mysql_prlock_init(key_MDL_context_LOCK_waiting_for, &m_LOCK_waiting_for);
+  for (uint i= 0; i < MDL_LOCK_CACHE_SIZE; i++)
+    m_lock_cache[i]= NULL;
 }
 
 
@@ -1535,6 +1558,107 @@ bool MDL_context::fix_pins()
 }
 
 
+/**
+  Find MDL_lock object for the key among the objects cached by this
+  context and pin it.
+
+  The cached objects are not pinned, so they are used only if no MDL_lock
+  object has been destroyed since they were cached, as a destroyed object
+  can be freed and reused for another key. The number of destroyed objects
+  is checked again once the object is pinned: if it still hasn't changed,
+  the object can't be freed until it is unpinned.
+
+  @param[in]  key  Key for which MDL_lock object needs to be found.
+  @param[out] idx  Index of the object in m_lock_cache.
+
+  @retval non-NULL - MDL_lock object for the key, pinned by m_pins. It may
+                     be marked as destroyed concurrently.
+  @retval NULL     - The object is not cached.
+*/
+
+MDL_lock *MDL_context::find_cached_lock(const MDL_key *key, uint *idx)
+{
+  if (m_lock_cache_version != mdl_locks.get_destroyed_locks_count())
+  {
+    clear_lock_cache();
+    return NULL;
+  }
+
+  for (uint i= 0; i < MDL_LOCK_CACHE_SIZE; i++)
+  {
+    MDL_lock *lock= m_lock_cache[i];
+    if (lock && lock->key.is_equal(key))
+    {
+      /* The pin used for the result of lf_hash_search(). */
+      lf_pin(m_pins, 2, lock);
+      if (m_lock_cache_version != mdl_locks.get_destroyed_locks_count())
+      {
+        lf_hash_search_unpin(m_pins);
+        clear_lock_cache();
+        return NULL;
+      }
+      *idx= i;
+      return lock;
+    }
+  }
+  return NULL;
+}
+
+
+/**
+  Add MDL_lock object to the objects cached by this context, replacing
+  the oldest one if there is no free element.
+
+  @param[in] lock  MDL_lock object on which this context has just acquired
+                   a "fast path" lock, so that it can't be destroyed before
+                   the number of destroyed objects is read.
+*/
+
+void MDL_context::cache_lock(MDL_lock *lock)
+{
+  const int32 version= mdl_locks.get_destroyed_locks_count();
+  if (version != m_lock_cache_version)
+  {
+    clear_lock_cache();
+    m_lock_cache_version= version;
+  }
+
+  uint idx= m_lock_cache_victim;
+  for (uint i= 0; i < MDL_LOCK_CACHE_SIZE; i++)
+  {
+    if (m_lock_cache[i] == lock)
+      return;
+    if (! m_lock_cache[i])
+      idx= i;
+  }
+  if (idx == m_lock_cache_victim)
+    m_lock_cache_victim= (idx + 1) % MDL_LOCK_CACHE_SIZE;
+
+  m_lock_cache[idx]= lock;
+}
+
+
+/**
+  Remove MDL_lock object from the cache of this context.
+*/
+
+void MDL_context::uncache_lock(uint idx)
+{
+  m_lock_cache[idx]= NULL;
+}
+
+
+/**
+  Remove all MDL_lock objects from the cache of this context.
+*/
+
+void MDL_context::clear_lock_cache()
+{
+  for (uint i= 0; i < MDL_LOCK_CACHE_SIZE; i++)
+    m_lock_cache[i]= NULL;
+}
+
+
 /**
   Initialize a lock request.
 
@@ -3001,6 +3125,7 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
   MDL_lock::fast_path_state_t unobtrusive_lock_increment;
   bool force_slow;
   bool pinned;
+  uint cache_idx;
 
   DBUG_ASSERT(mdl_request->ticket == NULL);
 
@@ -3113,6 +3238,54 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
     mysql_mdl_set_status(ticket->m_psi, MDL_ticket::PENDING);
   }
 
+  if (! force_slow && (lock= find_cached_lock(key, &cache_idx)))
+  {
+    /*
+      "Fast path" using MDL_lock object cached by this context, without
+      look-up in MDL_map.
+
+      find_cached_lock() has pinned the object and checked that it was not
+      reused for another key, but it could be marked as destroyed after
+      that. In this case it is dropped from the cache and we look it up
+      again. If there are "obtrusive" locks we take "slow path" after the
+      usual look-up as well.
+    */
+    MDL_lock::fast_path_state_t old_state= lock->m_fast_path_state;
+    bool first_use;
+    bool acquired= false;
+
+    do
+    {
+      if (old_state & (MDL_lock::IS_DESTROYED | MDL_lock::HAS_OBTRUSIVE))
+        break;
+      first_use= (old_state == 0);
+    }
+    while (! (acquired= lock->fast_path_state_cas(&old_state,
+                          old_state + unobtrusive_lock_increment)));
+
+    lf_hash_search_unpin(m_pins);
+
+    if (acquired)
+    {
+      /* Cached objects are never singletons, @sa cache_lock() call below. */
+      if (first_use)
+        mdl_locks.lock_object_used();
+
+      ticket->m_lock= lock;
+      ticket->m_is_fast_path= true;
+
+      m_tickets[mdl_request->duration].push_front(ticket);
+
+      mdl_request->ticket= ticket;
+
+      mysql_mdl_set_status(ticket->m_psi, MDL_ticket::GRANTED);
+      return FALSE;
+    }
+
+    if (old_state & MDL_lock::IS_DESTROYED)
+      uncache_lock(cache_idx);
+  }
+
 retry:
   /*
     The below call pins pointer to returned MDL_lock object (unless
@@ -3219,7 +3392,14 @@ retry:
     */
 
     if (pinned)
+    {
+      /*
+        Remember the object so repeated requests for the key can skip
+        the look-up. Singletons are not worth caching.
+      */
+      cache_lock(lock);
       lf_hash_search_unpin(m_pins);
+    }
 
     /*
       Don't count singleton MDL_lock objects as used, use "pinned == false"
@@ -869,6 +869,12 @@ typedef I_P_List<MDL_request, I_P_List_adapter<MDL_request,
                  I_P_List_counter>
         MDL_request_list;
 
+/**
+  Number of MDL_lock objects cached by each MDL_context.
+  Can't exceed the number of pins in LF_PINS (LF_PINBOX_PINS).
+*/
+#define MDL_LOCK_CACHE_SIZE 4
+
 /**
   Context of the owner of metadata locks. I.e. each server
   connection has such a context.
@@ -1115,6 +1121,19 @@ private:
     when searching for unused objects to free.
   */
   uint m_rand_state;
+  /**
+    MDL_lock objects on which this context has recently acquired locks
+    using "fast path". Repeated requests for the same keys use them
+    directly instead of looking them up in MDL_map::m_locks. The objects
+    are not pinned while cached, so the elements are only valid as long as
+    no MDL_lock object has been destroyed since m_lock_cache_version.
+    NULL elements are unused.
+  */
+  MDL_lock *m_lock_cache[MDL_LOCK_CACHE_SIZE];
+  /** Number of destroyed MDL_lock objects for which m_lock_cache is valid. */
+  int32 m_lock_cache_version;
+  /** Element of m_lock_cache to be replaced next. */
+  uint m_lock_cache_victim;
 
 private:
   MDL_ticket *find_ticket(MDL_request *mdl_req,
@@ -1125,6 +1144,10 @@ private:
                              MDL_ticket **out_ticket);
   void materialize_fast_path_locks();
   inline bool fix_pins();
+  MDL_lock *find_cached_lock(const MDL_key *key, uint *idx);
+  void cache_lock(MDL_lock *lock);
+  void uncache_lock(uint idx);
+  void clear_lock_cache();
 
 public:
   void find_deadlock();
@@ -314,6 +314,7 @@ my_bool opt_log_queries_not_using_indexes= 0;
 ulong opt_log_throttle_queries_not_using_indexes= 0;
 bool opt_disable_networking=0, opt_skip_show_db=0;
 bool opt_skip_name_resolve=0;
+my_bool opt_protocol_compression_lz4= 0;
 my_bool opt_character_set_client_handshake= 1;
 bool server_id_supplied = false;
 bool opt_endinfo, using_udf_functions;
@@ -359,6 +360,7 @@ my_bool opt_skip_slave_start = 0; ///< If set, slave is not autostarted
 my_bool opt_reckless_slave = 0;
 my_bool opt_enable_named_pipe= 0;
 my_bool opt_local_infile, opt_slave_compressed_protocol;
+my_bool opt_slave_compression_lz4= 0;
 my_bool opt_safe_user_create = 0;
 my_bool opt_show_slave_auth_info;
 my_bool opt_log_slave_updates= 0;
@@ -7127,6 +7129,10 @@ SHOW_VAR status_vars[]= {
   {"Opened_files",             (char*) &my_file_total_opened,                         SHOW_LONG_NOFLUSH,       SHOW_SCOPE_GLOBAL},
   {"Opened_tables",            (char*) offsetof(STATUS_VAR, opened_tables),           SHOW_LONGLONG_STATUS,    SHOW_SCOPE_ALL},
   {"Opened_table_definitions", (char*) offsetof(STATUS_VAR, opened_shares),           SHOW_LONGLONG_STATUS,    SHOW_SCOPE_ALL},
+  {"Optimizer_plan_cache_hits",   (char*) offsetof(STATUS_VAR, plan_cache_hits),  SHOW_LONGLONG_STATUS,    SHOW_SCOPE_ALL},
+  {"Optimizer_plan_cache_misses", (char*) offsetof(STATUS_VAR, plan_cache_misses), SHOW_LONGLONG_STATUS,    SHOW_SCOPE_ALL},
+  {"Parse_cache_hits",         (char*) offsetof(STATUS_VAR, parse_cache_hits),        SHOW_LONGLONG_STATUS,    SHOW_SCOPE_ALL},
+  {"Parse_cache_misses",       (char*) offsetof(STATUS_VAR, parse_cache_misses),      SHOW_LONGLONG_STATUS,    SHOW_SCOPE_ALL},
   {"Prepared_stmt_count",      (char*) &show_prepared_stmt_count,                     SHOW_FUNC,               SHOW_SCOPE_GLOBAL},
   {"Qcache_free_blocks",       (char*) &query_cache.free_memory_blocks,               SHOW_LONG_NOFLUSH,       SHOW_SCOPE_GLOBAL},
   {"Qcache_free_memory",       (char*) &query_cache.free_memory,                      SHOW_LONG_NOFLUSH,       SHOW_SCOPE_GLOBAL},
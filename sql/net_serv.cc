@@ -48,6 +48,10 @@
 
 #include <algorithm>
 
+#ifdef HAVE_COMPRESS
+#include <lz4.h>
+#endif
+
 using std::min;
 using std::max;
 
@@ -83,11 +87,62 @@ extern void thd_increment_bytes_received(size_t length);
 
 /* Additional instrumentation hooks for the server */
 #include "mysql_com_server.h"
+
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
 #endif
 
 #define VIO_SOCKET_ERROR  ((size_t) -1)
 
 static my_bool net_write_buff(NET *, const uchar *, size_t);
+#if defined(MYSQL_SERVER) && !defined(_WIN32)
+static my_bool net_write_vector(NET *, const NET_PIECE *, uint, size_t);
+
+/** Most pieces of a packet written with one gather write. */
+#define NET_WRITE_VECTOR_SIZE 64
+#endif
+
+#ifdef HAVE_COMPRESS
+/** How far back an LZ4 compressed packet can refer to earlier data. */
+#define NET_LZ4_HISTORY_SIZE (64 * 1024)
+
+/**
+  Size of the buffers holding the history of each direction. Packets are
+  appended behind the history until the buffer is full, so the history
+  only has to be moved to the start of the buffer once per
+  NET_LZ4_BUFFER_SIZE - NET_LZ4_HISTORY_SIZE bytes.
+*/
+#define NET_LZ4_BUFFER_SIZE (2 * NET_LZ4_HISTORY_SIZE)
+
+/**
+  Streaming context of the LZ4 compressed protocol.
+
+  Every packet sent goes through the compressor, also when it ends up
+  being sent uncompressed, and every packet received is appended to the
+  read history. The receiver thus holds all data the compressor of the
+  peer can refer to, and a packet is compressed against the packets sent
+  before it, which is what makes the small and similar packets of a
+  result set compress well.
+*/
+typedef struct st_net_lz4_context
+{
+  LZ4_stream_t stream;
+  /** LZ4 acceleration derived from the compression level, 1 is best. */
+  int acceleration;
+  /** Length of the data in write_buffer, ending at the stream history. */
+  size_t write_length;
+  /** Length of the data in read_buffer, ending at the read history. */
+  size_t read_length;
+  /** Copy of the compressed packet being decompressed. */
+  uchar *read_packet;
+  size_t read_packet_size;
+  char write_buffer[NET_LZ4_BUFFER_SIZE];
+  char read_buffer[NET_LZ4_BUFFER_SIZE];
+} NET_LZ4_CONTEXT;
+
+static void net_free_compression_lz4(NET *net);
+#endif
 
 /** Init with packet info. */
 
@@ -109,7 +164,7 @@ my_bool my_net_init(NET *net, Vio* vio)
   net->compress=0; net->reading_or_writing=0;
   net->where_b = net->remain_in_buf=0;
   net->last_errno=0;
-  net->unused= 0;
+  net->compress_context= 0;
 #ifdef MYSQL_SERVER
   net->extension= NULL;
 #endif
@@ -129,6 +184,9 @@ void net_end(NET *net)
   DBUG_ENTER("net_end");
   my_free(net->buff);
   net->buff=0;
+#ifdef HAVE_COMPRESS
+  net_free_compression_lz4(net);
+#endif
   DBUG_VOID_RETURN;
 }
 
@@ -328,6 +386,84 @@ my_bool my_net_write(NET *net, const uchar *packet, size_t len)
 }
 
 
+#ifdef MYSQL_SERVER
+/**
+  Write a logical packet made of several pieces of data, like a row
+  with long values that are sent from where they are.
+
+  Packets that fit in the packet buffer are copied into it as with
+  my_net_write(). Longer ones are written on plain socket connections
+  together with what is in the buffer by one gather write, without
+  copying the pieces.
+
+  @param net     NET handler
+  @param pieces  The pieces of the packet, in order
+  @param count   Number of pieces
+
+  @retval 0 ok
+  @retval 1 error
+*/
+
+my_bool my_net_write_pieces(NET *net, const NET_PIECE *pieces, uint count)
+{
+  uchar buff[NET_HEADER_SIZE];
+  size_t length= 0, offset= 0, chunk;
+  uint i;
+
+  if (unlikely(!net->vio)) /* nowhere to write */
+    return 0;
+
+  for (i= 0; i < count; i++)
+    length+= pieces[i].length;
+
+#ifndef _WIN32
+  if (length + NET_HEADER_SIZE > (size_t) (net->buff_end - net->write_pos) &&
+      length < MAX_PACKET_LENGTH && count < NET_WRITE_VECTOR_SIZE &&
+      !net->compress &&
+      (vio_type(net->vio) == VIO_TYPE_TCPIP ||
+       vio_type(net->vio) == VIO_TYPE_SOCKET))
+    return net_write_vector(net, pieces, count, length);
+#endif
+
+  MYSQL_NET_WRITE_START(length);
+
+  /* Split into packets of at most MAX_PACKET_LENGTH like my_net_write() */
+  do
+  {
+    size_t left;
+    chunk= min<size_t>(length, MAX_PACKET_LENGTH);
+    int3store(buff, static_cast<uint>(chunk));
+    buff[3]= (uchar) net->pkt_nr++;
+    if (net_write_buff(net, buff, NET_HEADER_SIZE))
+    {
+      MYSQL_NET_WRITE_DONE(1);
+      return 1;
+    }
+    length-= chunk;
+    for (left= chunk; left; )
+    {
+      size_t part= min(left, pieces->length - offset);
+      if (part && net_write_buff(net, pieces->data + offset, part))
+      {
+        MYSQL_NET_WRITE_DONE(1);
+        return 1;
+      }
+      left-= part;
+      offset+= part;
+      if (offset == pieces->length)
+      {
+        pieces++;
+        offset= 0;
+      }
+    }
+  } while (chunk == MAX_PACKET_LENGTH);
+
+  MYSQL_NET_WRITE_DONE(0);
+  return 0;
+}
+#endif /* MYSQL_SERVER */
+
+
 /**
   Send a command to the server.
 
@@ -480,6 +616,30 @@ net_write_buff(NET *net, const uchar *packet, size_t len)
 }
 
 
+/**
+  Mark the connection as broken after a failed write.
+
+  @param  net     NET handler.
+*/
+
+static void
+net_set_write_error(NET *net)
+{
+  /* Socket should be closed. */
+  net->error= 2;
+
+  /* Interrupted by a timeout? */
+  if (vio_was_timeout(net->vio))
+    net->last_errno= ER_NET_WRITE_INTERRUPTED;
+  else
+    net->last_errno= ER_NET_ERROR_ON_WRITE;
+
+#ifdef MYSQL_SERVER
+  my_error(net->last_errno, MYF(0));
+#endif
+}
+
+
 /**
   Write a determined number of bytes to a network handler.
 
@@ -518,25 +678,169 @@ net_write_raw_loop(NET *net, const uchar *buf, size_t count)
 
   /* On failure, propagate the error code. */
   if (count)
+    net_set_write_error(net);
+
+  return MY_TEST(count);
+}
+
+
+#if defined(MYSQL_SERVER) && !defined(_WIN32)
+/**
+  Write pieces of data to a plain socket with gather writes.
+
+  @param  net     NET handler.
+  @param  iov     The pieces to write, modified on partial writes.
+  @param  iovcnt  Number of pieces.
+  @param  count   Total length of the pieces.
+
+  @return TRUE on error, FALSE on success.
+*/
+
+static my_bool
+net_write_vector_loop(NET *net, struct iovec *iov, int iovcnt, size_t count)
+{
+  unsigned int retry_count= 0;
+
+  while (count)
   {
-    /* Socket should be closed. */
-    net->error= 2;
+    size_t sentcnt= vio_write_vector(net->vio, iov, iovcnt);
 
-    /* Interrupted by a timeout? */
-    if (vio_was_timeout(net->vio))
-      net->last_errno= ER_NET_WRITE_INTERRUPTED;
-    else
-      net->last_errno= ER_NET_ERROR_ON_WRITE;
+    /* VIO_SOCKET_ERROR (-1) indicates an error. */
+    if (sentcnt == VIO_SOCKET_ERROR)
+    {
+      /* A recoverable I/O error occurred? */
+      if (net_should_retry(net, &retry_count))
+        continue;
+      else
+        break;
+    }
 
-#ifdef MYSQL_SERVER
-    my_error(net->last_errno, MYF(0));
-#endif
+    count-= sentcnt;
+    thd_increment_bytes_sent(sentcnt);
+
+    /* Skip the data that has been written. */
+    while (iovcnt && sentcnt >= iov->iov_len)
+    {
+      sentcnt-= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+    if (sentcnt)
+    {
+      iov->iov_base= (char *) iov->iov_base + sentcnt;
+      iov->iov_len-= sentcnt;
+    }
   }
 
+  /* On failure, propagate the error code. */
+  if (count)
+    net_set_write_error(net);
+
   return MY_TEST(count);
 }
 
 
+/**
+  Write what is in the packet buffer followed by a packet made of several
+  pieces with one gather write, see my_net_write_pieces().
+
+  @return TRUE on error, FALSE on success.
+*/
+
+static my_bool
+net_write_vector(NET *net, const NET_PIECE *pieces, uint count,
+                 size_t length)
+{
+  struct iovec iov[NET_WRITE_VECTOR_SIZE];
+  uchar *header;
+  my_bool res;
+  uint i;
+
+  DBUG_ASSERT(count < NET_WRITE_VECTOR_SIZE && length < MAX_PACKET_LENGTH);
+
+  /* Socket can't be used */
+  if (net->error == 2)
+    return TRUE;
+
+  /* The packet header is put in the buffer, behind the packets there. */
+  if (net->buff_end - net->write_pos < NET_HEADER_SIZE && net_flush(net))
+    return TRUE;
+  header= net->write_pos;
+  int3store(header, static_cast<uint>(length));
+  header[3]= (uchar) net->pkt_nr++;
+  net->write_pos+= NET_HEADER_SIZE;
+
+  iov[0].iov_base= net->buff;
+  iov[0].iov_len= net->write_pos - net->buff;
+  query_cache_insert((char *) net->buff, iov[0].iov_len, net->pkt_nr);
+  for (i= 0; i < count; i++)
+  {
+    iov[i + 1].iov_base= (void *) pieces[i].data;
+    iov[i + 1].iov_len= pieces[i].length;
+    query_cache_insert((const char *) pieces[i].data, pieces[i].length,
+                       net->pkt_nr);
+  }
+
+  MYSQL_NET_WRITE_START(length);
+  net->reading_or_writing= 2;
+  res= net_write_vector_loop(net, iov, count + 1, iov[0].iov_len + length);
+  net->reading_or_writing= 0;
+  net->write_pos= net->buff;
+  MYSQL_NET_WRITE_DONE(res);
+
+  return res;
+}
+#endif
+
+
+#ifdef HAVE_COMPRESS
+/**
+  Compress a packet with the LZ4 streaming context of a connection.
+
+  The packet is copied behind the history in the write buffer when it
+  fits, so that the history is one contiguous block. Larger packets are
+  compressed where they are, and their tail is saved as the history.
+
+  @param          ctx      LZ4 context of the connection.
+  @param          packet   The packet to compress.
+  @param          length   Length of the packet.
+  @param[out]     to       Buffer of at least LZ4_COMPRESSBOUND(length).
+
+  @return Length of the compressed packet, 0 on failure.
+*/
+
+static size_t
+net_lz4_compress(NET_LZ4_CONTEXT *ctx, const uchar *packet, size_t length,
+                 uchar *to)
+{
+  const char *source= (const char *) packet;
+  int compr_length;
+
+  if (ctx->write_length + length > NET_LZ4_BUFFER_SIZE)
+    ctx->write_length= LZ4_saveDict(&ctx->stream, ctx->write_buffer,
+                                    NET_LZ4_HISTORY_SIZE);
+
+  if (ctx->write_length + length <= NET_LZ4_BUFFER_SIZE)
+  {
+    memcpy(ctx->write_buffer + ctx->write_length, packet, length);
+    source= ctx->write_buffer + ctx->write_length;
+  }
+
+  compr_length= LZ4_compress_fast_continue(&ctx->stream, source, (char *) to,
+                                           (int) length,
+                                           LZ4_compressBound((int) length),
+                                           ctx->acceleration);
+
+  if (source == (const char *) packet)
+    ctx->write_length= LZ4_saveDict(&ctx->stream, ctx->write_buffer,
+                                    NET_LZ4_HISTORY_SIZE);
+  else
+    ctx->write_length+= length;
+
+  return compr_length > 0 ? (size_t) compr_length : 0;
+}
+
+
 /**
   Compress and encapsulate a packet into a compressed packet.
 
@@ -557,23 +861,45 @@ compress_packet(NET *net, const uchar *packet, size_t *length)
   uchar *compr_packet;
   size_t compr_length;
   const uint header_length= NET_HEADER_SIZE + COMP_HEADER_SIZE;
+  NET_LZ4_CONTEXT *lz4= (NET_LZ4_CONTEXT *) net->compress_context;
+  const size_t buffer_length= lz4 ? LZ4_COMPRESSBOUND(*length) : *length;
 
   compr_packet= (uchar *) my_malloc(key_memory_NET_compress_packet,
-                                    *length + header_length, MYF(MY_WME));
+                                    buffer_length + header_length,
+                                    MYF(MY_WME));
 
   if (compr_packet == NULL)
     return NULL;
 
-  memcpy(compr_packet + header_length, packet, *length);
-
-  /* Compress the encapsulated packet. */
-  if (my_compress(compr_packet + header_length, length, &compr_length))
+  if (lz4)
   {
     /*
-      If the length of the compressed packet is larger than the
-      original packet, the original packet is sent uncompressed.
+      Packets too short for zlib are compressed as well: they have to be
+      part of the history, and may well match the packets before them.
     */
-    compr_length= 0;
+    compr_length= net_lz4_compress(lz4, packet, *length,
+                                   compr_packet + header_length);
+    if (compr_length && compr_length < *length)
+      std::swap(compr_length, *length);
+    else
+    {
+      memcpy(compr_packet + header_length, packet, *length);
+      compr_length= 0;
+    }
+  }
+  else
+  {
+    memcpy(compr_packet + header_length, packet, *length);
+
+    /* Compress the encapsulated packet. */
+    if (my_compress(compr_packet + header_length, length, &compr_length))
+    {
+      /*
+        If the length of the compressed packet is larger than the
+        original packet, the original packet is sent uncompressed.
+      */
+      compr_length= 0;
+    }
   }
 
   /* Length of the compressed (original) packet. */
@@ -587,6 +913,7 @@ compress_packet(NET *net, const uchar *packet, size_t *length)
 
   return compr_packet;
 }
+#endif /* HAVE_COMPRESS */
 
 
 /**
@@ -869,6 +1196,92 @@ error:
 }
 
 
+#ifdef HAVE_COMPRESS
+/**
+  Append received data to the read history of the LZ4 context.
+*/
+
+static void
+net_lz4_remember(NET_LZ4_CONTEXT *ctx, const uchar *data, size_t length)
+{
+  if (length >= NET_LZ4_HISTORY_SIZE)
+  {
+    memcpy(ctx->read_buffer, data + length - NET_LZ4_HISTORY_SIZE,
+           NET_LZ4_HISTORY_SIZE);
+    ctx->read_length= NET_LZ4_HISTORY_SIZE;
+    return;
+  }
+
+  if (ctx->read_length + length > NET_LZ4_BUFFER_SIZE)
+  {
+    memmove(ctx->read_buffer,
+            ctx->read_buffer + ctx->read_length - NET_LZ4_HISTORY_SIZE,
+            NET_LZ4_HISTORY_SIZE);
+    ctx->read_length= NET_LZ4_HISTORY_SIZE;
+  }
+
+  memcpy(ctx->read_buffer + ctx->read_length, data, length);
+  ctx->read_length+= length;
+}
+
+
+/**
+  Uncompress the payload of a compressed packet in place.
+
+  @param          net      NET handler.
+  @param          packet   The payload, replaced with the original data.
+  @param          len      Length of the payload.
+  @param[in,out]  complen  Length of the original data, 0 if the payload
+                           is not compressed. Set to the length of the
+                           data in the packet.
+
+  @return TRUE on error, FALSE on success.
+*/
+
+static my_bool
+net_uncompress_packet(NET *net, uchar *packet, size_t len, size_t *complen)
+{
+  NET_LZ4_CONTEXT *ctx= (NET_LZ4_CONTEXT *) net->compress_context;
+
+  if (ctx == NULL)
+    return my_uncompress(packet, len, complen);
+
+  if (*complen)
+  {
+    if (len > ctx->read_packet_size)
+    {
+      uchar *buff= (uchar *) my_realloc(key_memory_NET_compress_packet,
+                                        ctx->read_packet, len,
+                                        MYF(MY_WME | MY_ALLOW_ZERO_PTR));
+      if (buff == NULL)
+        return TRUE;
+      ctx->read_packet= buff;
+      ctx->read_packet_size= len;
+    }
+    memcpy(ctx->read_packet, packet, len);
+
+    const size_t dict_length= min<size_t>(ctx->read_length,
+                                          NET_LZ4_HISTORY_SIZE);
+    if (LZ4_decompress_safe_usingDict((const char *) ctx->read_packet,
+                                      (char *) packet, (int) len,
+                                      (int) *complen,
+                                      ctx->read_buffer + ctx->read_length -
+                                      dict_length,
+                                      (int) dict_length) != (int) *complen)
+    {
+      DBUG_PRINT("error", ("Can't uncompress LZ4 packet"));
+      return TRUE;
+    }
+  }
+  else
+    *complen= len;
+
+  net_lz4_remember(ctx, packet, *complen);
+  return FALSE;
+}
+#endif /* HAVE_COMPRESS */
+
+
 /**
   Read a packet from the client/server and return it without the internal
   package header.
@@ -1008,8 +1421,8 @@ my_net_read(NET *net)
         MYSQL_NET_READ_DONE(1, 0);
         return packet_error;
       }
-      if (my_uncompress(net->buff + net->where_b, packet_len,
-                        &complen))
+      if (net_uncompress_packet(net, net->buff + net->where_b, packet_len,
+                                &complen))
       {
         net->error= 2;			/* caller will close socket */
         net->last_errno= ER_NET_UNCOMPRESS_ERROR;
@@ -1061,3 +1474,65 @@ void my_net_set_write_timeout(NET *net, uint timeout)
   DBUG_VOID_RETURN;
 }
 
+
+#ifdef HAVE_COMPRESS
+/**
+  Switch the compressed protocol of a connection from zlib to LZ4 with a
+  streaming context. Both peers must do so at the same point of the
+  packet stream, right after they have agreed on CLIENT_COMPRESS_LZ4.
+
+  @param  net    NET handler.
+  @param  level  Compression level, see my_net_set_compression_level().
+
+  @return TRUE on out of memory, FALSE on success.
+*/
+
+my_bool my_net_set_compression_lz4(NET *net, uint level)
+{
+  NET_LZ4_CONTEXT *ctx;
+  DBUG_ENTER("my_net_set_compression_lz4");
+
+  net_free_compression_lz4(net);
+  if (!(ctx= (NET_LZ4_CONTEXT *) my_malloc(key_memory_NET_compress_packet,
+                                           sizeof(NET_LZ4_CONTEXT),
+                                           MYF(MY_WME))))
+    DBUG_RETURN(TRUE);
+
+  LZ4_resetStream(&ctx->stream);
+  ctx->write_length= ctx->read_length= 0;
+  ctx->read_packet= NULL;
+  ctx->read_packet_size= 0;
+  net->compress_context= ctx;
+  my_net_set_compression_level(net, level);
+  DBUG_RETURN(FALSE);
+}
+
+
+/**
+  Set the level of LZ4 protocol compression of a connection: 1 is the
+  fastest, 9 compresses best. Only affects the packets sent, and does
+  nothing if the connection does not use LZ4.
+*/
+
+void my_net_set_compression_level(NET *net, uint level)
+{
+  NET_LZ4_CONTEXT *ctx= (NET_LZ4_CONTEXT *) net->compress_context;
+  DBUG_ENTER("my_net_set_compression_level");
+  DBUG_PRINT("enter", ("level: %u", level));
+  if (ctx)
+    ctx->acceleration= 10 - (int) max(1U, min(level, 9U));
+  DBUG_VOID_RETURN;
+}
+
+
+static void net_free_compression_lz4(NET *net)
+{
+  NET_LZ4_CONTEXT *ctx= (NET_LZ4_CONTEXT *) net->compress_context;
+  if (ctx)
+  {
+    my_free(ctx->read_packet);
+    my_free(ctx);
+    net->compress_context= NULL;
+  }
+}
+#endif /* HAVE_COMPRESS */
@@ -1665,7 +1665,8 @@ bool Explain_join::explain_extra()
         static_cast<JOIN_CACHE*>(tab->op)->cache_type();
       StringBuffer<64> buff(cs);
       if (t == JOIN_CACHE::ALG_BNL)
-        buff.append("Block Nested Loop");
+        buff.append(static_cast<JOIN_CACHE_BNL*>(tab->op)->is_hashed() ?
+                    "Hash Join" : "Block Nested Loop");
         else if (t == JOIN_CACHE::ALG_BKA)
         buff.append("Batched Key Access");
       else if (t == JOIN_CACHE::ALG_BKA_UNIQUE)
@@ -137,6 +137,13 @@ public:
   { return from ? store(from, strlen(from), fromcs) : store_null(); }
   inline bool store(String *str)
   { return store((char*) str->ptr(), str->length(), str->charset()); }
+  /**
+    Send a string that stays where it is until end_row(), so that it may
+    be sent from there instead of being copied.
+  */
+  virtual bool store_stable(const char *from, size_t length,
+                            const CHARSET_INFO *fromcs)
+  { return store(from, length, fromcs); }
   inline bool store(const LEX_STRING &s, const CHARSET_INFO *cs)
   { return store(s.str, s.length, cs); }
 
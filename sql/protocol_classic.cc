@@ -55,6 +55,28 @@ bool Protocol_classic::net_store_data(const uchar *from, size_t length)
   packet->length((uint) (to+length-(uchar *) packet->ptr()));
   return 0;
 }
+
+
+/**
+  Store the length of a value in the packet and remember where the value
+  is, to send it from there in end_row().
+*/
+
+bool Protocol_classic::store_row_piece(const char *from, size_t length)
+{
+  size_t packet_length= packet->length();
+  if (packet_length + 9 > packet->alloced_length() &&
+      packet->mem_realloc(packet_length + 9))
+    return 1;
+  uchar *to= net_store_length((uchar *) packet->ptr() + packet_length, length);
+  packet->length((uint) (to - (uchar *) packet->ptr()));
+
+  Row_piece *piece= &m_row_pieces[m_row_piece_count++];
+  piece->offset= packet->length();
+  piece->data= from;
+  piece->length= length;
+  return 0;
+}
 #endif
 
 
@@ -620,6 +642,10 @@ void Protocol_classic::init(THD *thd_arg)
 #ifndef DBUG_OFF
   field_types= 0;
 #endif
+#ifndef EMBEDDED_LIBRARY
+  m_row_piece_count= 0;
+  m_store_stable= false;
+#endif
 }
 
 
@@ -1193,10 +1219,40 @@ bool Protocol_classic::send_field_metadata(Send_field *field,
 bool Protocol_classic::end_row()
 {
   DBUG_ENTER("Protocol_classic::end_row");
-  if (m_thd->get_protocol()->connection_alive())
+  if (!m_thd->get_protocol()->connection_alive())
+    DBUG_RETURN(0);
+  if (!m_row_piece_count)
     DBUG_RETURN(my_net_write(&m_thd->net, (uchar *) packet->ptr(),
                              packet->length()));
-  DBUG_RETURN(0);
+
+  /* Interleave the parts of the packet with the values not copied */
+  NET_PIECE pieces[2 * MAX_ROW_PIECES + 1];
+  const uchar *ptr= (const uchar *) packet->ptr();
+  size_t offset= 0;
+  uint count= 0;
+  for (uint i= 0; i < m_row_piece_count; i++)
+  {
+    pieces[count].data= ptr + offset;
+    pieces[count++].length= m_row_pieces[i].offset - offset;
+    pieces[count].data= (const uchar *) m_row_pieces[i].data;
+    pieces[count++].length= m_row_pieces[i].length;
+    offset= m_row_pieces[i].offset;
+  }
+  pieces[count].data= ptr + offset;
+  pieces[count++].length= packet->length() - offset;
+  m_row_piece_count= 0;
+
+  DBUG_RETURN(my_net_write_pieces(&m_thd->net, pieces, count));
+}
+
+
+bool Protocol_classic::store_stable(const char *from, size_t length,
+                                    const CHARSET_INFO *fromcs)
+{
+  m_store_stable= true;
+  bool res= store(from, length, fromcs);
+  m_store_stable= false;
+  return res;
 }
 #endif /* EMBEDDED_LIBRARY */
 
@@ -1245,6 +1301,7 @@ void Protocol_text::start_row()
   field_pos= 0;
 #endif
   packet->length(0);
+  m_row_piece_count= 0;
 }
 
 
@@ -1278,6 +1335,12 @@ bool Protocol_classic::store_string_aux(const char *from, size_t length,
     return net_store_data((uchar *) from, length, fromcs, tocs);
   }
   /* Store without conversion */
+#ifndef EMBEDDED_LIBRARY
+  /* Send long values from where they are if they stay there */
+  if (m_store_stable && length >= MIN_ROW_PIECE_LENGTH &&
+      m_row_piece_count < MAX_ROW_PIECES)
+    return store_row_piece(from, length);
+#endif
   return net_store_data((uchar *) from, length);
 }
 
@@ -1558,6 +1621,7 @@ void Protocol_binary::start_row()
   packet->length(bit_fields+1);
   memset(const_cast<char*>(packet->ptr()), 0, 1+bit_fields);
   field_pos=0;
+  m_row_piece_count= 0;
 }
 #endif
 
@@ -44,7 +44,28 @@ protected:
   uchar *raw_packet;
   CHARSET_INFO *result_cs;
 #ifndef EMBEDDED_LIBRARY
+  /**
+    A long value of the current row that is sent from where it is when
+    the row ends, instead of being copied into the packet.
+  */
+  struct Row_piece
+  {
+    /** Position in the packet the value belongs at */
+    size_t offset;
+    const char *data;
+    size_t length;
+  };
+  /** Most values of a row that are not copied */
+  static const uint MAX_ROW_PIECES= 16;
+  /** Shortest value that is not copied */
+  static const size_t MIN_ROW_PIECE_LENGTH= 4096;
+  Row_piece m_row_pieces[MAX_ROW_PIECES];
+  uint m_row_piece_count;
+  /** The value being stored stays valid until end_row() */
+  bool m_store_stable;
+
   bool net_store_data(const uchar *from, size_t length);
+  bool store_row_piece(const char *from, size_t length);
 #else
   char **next_field;
   MYSQL_FIELD *next_mysql_field;
@@ -104,6 +125,10 @@ public:
   virtual bool send_out_parameters(List<Item_param> *sp_params)=0;
   virtual void start_row()=0;
   virtual bool end_row();
+#ifndef EMBEDDED_LIBRARY
+  virtual bool store_stable(const char *from, size_t length,
+                            const CHARSET_INFO *fromcs);
+#endif
   virtual uint get_rw_status();
   virtual bool get_compression();
 
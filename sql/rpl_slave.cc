@@ -8866,7 +8866,11 @@ static int connect_to_master(THD* thd, MYSQL* mysql, Master_info* mi,
 #endif
   ulong client_flag= CLIENT_REMEMBER_OPTIONS;
   if (opt_slave_compressed_protocol)
-    client_flag|= CLIENT_COMPRESS;              /* We will use compression */
+  {
+    client_flag|= CLIENT_COMPRESS;              /* Use compression */
+    if (opt_slave_compression_lz4)
+      client_flag|= CLIENT_COMPRESS_LZ4;
+  }
 
   mysql_options(mysql, MYSQL_OPT_CONNECT_TIMEOUT, (char *) &slave_net_timeout);
   mysql_options(mysql, MYSQL_OPT_READ_TIMEOUT, (char *) &slave_net_timeout);
@@ -1768,7 +1768,7 @@ void close_thread_table(THD *thd, TABLE **table_ptr)
   if (table->file != NULL)
     table->file->unbind_psi();
 
-  Table_cache *tc= table_cache_manager.get_cache(thd);
+  Table_cache *tc= table->cache_instance;
 
   tc->lock();
 
@@ -3303,7 +3303,7 @@ bool open_table(THD *thd, TABLE_LIST *table_list, Open_table_context *ot_ctx)
 
 retry_share:
   {
-    Table_cache *tc= table_cache_manager.get_cache(thd);
+    Table_cache *tc= table_cache_manager.get_local_cache(thd);
 
     tc->lock();
 
@@ -3600,7 +3600,7 @@ share_found:
   }
   {
     /* Add new TABLE object to table cache for this connection. */
-    Table_cache *tc= table_cache_manager.get_cache(thd);
+    Table_cache *tc= table_cache_manager.get_local_cache(thd);
 
     tc->lock();
 
@@ -3625,7 +3625,7 @@ table_found:
         thd->backup_tables_lock.acquire_protection(thd, MDL_STATEMENT,
                                                    ot_ctx->get_timeout()))
     {
-      Table_cache *tc= table_cache_manager.get_cache(thd);
+      Table_cache *tc= table->cache_instance;
 
       tc->lock();
 
@@ -339,6 +339,7 @@ TODO list:
 #include <m_ctype.h>
 #include <my_dir.h>
 #include <hash.h>
+#include <my_atomic.h>
 #include "../storage/myisammrg/ha_myisammrg.h"
 #include "../storage/myisammrg/myrg_def.h"
 #include "probes_mysql.h"
@@ -686,6 +687,70 @@ static char *make_cache_key(THD *thd,
 }
 
 
+/**
+  Collation of the keys of the table hash.
+
+  If lower_case_table_names!=0 then db and table names are already
+  converted to lower case and we can use binary collation for their
+  comparison (no matter if file system case sensitive or not).
+  If we have case-sensitive file system (like on most Unixes) and
+  lower_case_table_names == 0 then we should distinguish my_table
+  and MY_TABLE cases and so again can use binary collation.
+
+  On windows, OS/2, MacOS X with HFS+ or any other case insensitive
+  file system if lower_case_table_names!=0 we have same situation as
+  in previous case, but if lower_case_table_names==0 then we should
+  not distinguish cases (to be compatible in behavior with underlying
+  file system) and so should use case insensitive collation for
+  comparison.
+*/
+
+static CHARSET_INFO *table_key_charset()
+{
+#ifndef FN_NO_CASE_SENSE
+  return &my_charset_bin;
+#else
+  return lower_case_table_names ? &my_charset_bin : files_charset_info;
+#endif
+}
+
+
+/**
+  Count a key in, or out of, a lock-free filter of the cache.
+
+  The key is hashed with the collation of the hash it is stored in, so
+  that keys which are equal in the hash use the same slot.
+
+  @pre structure_guard_mutex is acquired.
+*/
+
+void Query_cache::filter_add(volatile int32 *filter, const CHARSET_INFO *cs,
+                             const uchar *key, size_t key_length,
+                             int32 count)
+{
+  ulong nr1= 1, nr2= 4;
+  cs->coll->hash_sort(cs, key, key_length, &nr1, &nr2);
+  my_atomic_add32(&filter[nr1 % QUERY_CACHE_FILTER_SLOTS], count);
+}
+
+
+/**
+  Check without locking whether a key may be in a filter of the cache.
+
+  @return false if the key is certainly not in the cache, true if it may
+          be and the hash must be searched under structure_guard_mutex
+*/
+
+bool Query_cache::filter_may_contain(volatile int32 *filter,
+                                     const CHARSET_INFO *cs,
+                                     const uchar *key, size_t key_length)
+{
+  ulong nr1= 1, nr2= 4;
+  cs->coll->hash_sort(cs, key, key_length, &nr1, &nr2);
+  return my_atomic_load32(&filter[nr1 % QUERY_CACHE_FILTER_SLOTS]) != 0;
+}
+
+
 /**
   Serialize access to the query cache.
   If the lock cannot be granted the thread hangs in a conditional wait which
@@ -1401,6 +1466,8 @@ Query_cache::Query_cache(ulong query_cache_limit_arg,
   set_if_bigger(min_allocation_unit,min_needed);
   this->min_allocation_unit= ALIGN_SIZE(min_allocation_unit);
   set_if_bigger(this->min_result_data_size,min_allocation_unit);
+  memset(const_cast<int32*>(query_filter), 0, sizeof(query_filter));
+  memset(const_cast<int32*>(table_filter), 0, sizeof(table_filter));
 }
 
 
@@ -1654,6 +1721,8 @@ def_week_frmt: %lu, in_trans: %d, autocommit: %d",
 	double_linked_list_simple_include(query_block, &queries_blocks);
 	inserts++;
 	queries_in_cache++;
+	filter_add(query_filter, &my_charset_bin, (uchar*) cache_key,
+	           tot_length, 1);
 	thd->query_cache_tls.first_query_block= query_block;
 	header->writer(&thd->query_cache_tls);
 	header->tables_type(tables_type);
@@ -1932,18 +2001,6 @@ int Query_cache::send_result_to_client(THD *thd, const LEX_CSTRING &sql)
       goto err;
     }
   }
-  /*
-    Try to obtain an exclusive lock on the query cache. If the cache is
-    disabled or if a full cache flush is in progress, the attempt to
-    get the lock is aborted.
-
-    The 'TRUE' parameter indicate that the lock is allowed to timeout
-  */
-  if (try_lock(TRUE))
-    goto err;
-
-  if (query_cache_size == 0)
-    goto err_unlock;
 
   Query_cache_block *query_block;
   LEX_CSTRING stripped_query;
@@ -2011,6 +2068,30 @@ def_week_frmt: %lu, in_trans: %d, autocommit: %d",
                             ? stripped_query : thd->query(), &flags,
                             &tot_length);
   if (cache_key == NULL)
+    goto err;
+
+  /*
+    Most lookups are for queries which are not cached: tell them without
+    taking the lock.
+  */
+  if (!filter_may_contain(query_filter, &my_charset_bin, (uchar*) cache_key,
+                          tot_length))
+  {
+    DBUG_PRINT("qcache", ("No query in query filter"));
+    goto err;
+  }
+
+  /*
+    Try to obtain an exclusive lock on the query cache. If the cache is
+    disabled or if a full cache flush is in progress, the attempt to
+    get the lock is aborted.
+
+    The 'TRUE' parameter indicate that the lock is allowed to timeout
+  */
+  if (try_lock(TRUE))
+    goto err;
+
+  if (query_cache_size == 0)
     goto err_unlock;
 
   query_block = (Query_cache_block *)  my_hash_search(&queries,
@@ -2748,34 +2829,9 @@ ulong Query_cache::init_cache()
   (void) my_hash_init(&queries, &my_charset_bin, def_query_hash_size, 0, 0,
                       query_cache_query_get_key, 0, 0,
                       key_memory_Query_cache);
-#ifndef FN_NO_CASE_SENSE
-  /*
-    If lower_case_table_names!=0 then db and table names are already 
-    converted to lower case and we can use binary collation for their 
-    comparison (no matter if file system case sensitive or not).
-    If we have case-sensitive file system (like on most Unixes) and
-    lower_case_table_names == 0 then we should distinguish my_table
-    and MY_TABLE cases and so again can use binary collation.
-  */
-  (void) my_hash_init(&tables, &my_charset_bin, def_table_hash_size, 0, 0,
+  (void) my_hash_init(&tables, table_key_charset(), def_table_hash_size, 0, 0,
                       query_cache_table_get_key, 0, 0,
                       key_memory_Query_cache);
-#else
-  /*
-    On windows, OS/2, MacOS X with HFS+ or any other case insensitive
-    file system if lower_case_table_names!=0 we have same situation as
-    in previous case, but if lower_case_table_names==0 then we should
-    not distinguish cases (to be compatible in behavior with underlying
-    file system) and so should use case insensitive collation for
-    comparison.
-  */
-  (void) my_hash_init(&tables,
-                      lower_case_table_names ? &my_charset_bin :
-                      files_charset_info,
-                      def_table_hash_size, 0, 0,query_cache_table_get_key,
-                      0, 0,
-                      key_memory_Query_cache);
-#endif
 
   queries_in_cache = 0;
   queries_blocks = 0;
@@ -2826,6 +2882,8 @@ void Query_cache::free_cache()
   make_disabled();
   my_hash_free(&queries);
   my_hash_free(&tables);
+  memset(const_cast<int32*>(query_filter), 0, sizeof(query_filter));
+  memset(const_cast<int32*>(table_filter), 0, sizeof(table_filter));
   DBUG_VOID_RETURN;
 }
 
@@ -2929,6 +2987,12 @@ void Query_cache::free_query_internal(Query_cache_block *query_block)
 		      query_block->query()->length() ));
 
   queries_in_cache--;
+  {
+    size_t key_length;
+    const uchar *key=
+      query_cache_query_get_key((uchar*) query_block, &key_length, 0);
+    filter_add(query_filter, &my_charset_bin, key, key_length, -1);
+  }
 
   Query_cache_query *query= query_block->query();
 
@@ -3293,6 +3357,14 @@ void Query_cache::invalidate_table(THD *thd, TABLE *table)
 
 void Query_cache::invalidate_table(THD *thd, uchar * key, size_t key_length)
 {
+  /*
+    A table which no cached query uses has nothing to invalidate: don't
+    wait for the lock of the cache.
+  */
+  if (!filter_may_contain(table_filter, table_key_charset(), key,
+                          key_length))
+    return;
+
   DEBUG_SYNC(thd, "wait_in_query_cache_invalidate1");
 
   /*
@@ -3573,6 +3645,7 @@ Query_cache::insert_table(size_t key_len, const char *key,
       free_memory_block(table_block);
       DBUG_RETURN(0);
     }
+    filter_add(table_filter, table_key_charset(), (uchar*) key, key_len, 1);
     char *db= header->db();
     header->table(db + db_length + 1);
     header->key_length(key_len);
@@ -3632,6 +3705,10 @@ void Query_cache::unlink_table(Query_cache_block_table *node)
     Query_cache_block *table_block= neighbour->block();
     double_linked_list_exclude(table_block,
                                &tables_blocks);
+    size_t key_length;
+    const uchar *key=
+      query_cache_table_get_key((uchar*) table_block, &key_length, 0);
+    filter_add(table_filter, table_key_charset(), key, key_length, -1);
     my_hash_delete(&tables,(uchar *) table_block);
     free_memory_block(table_block);
   }
@@ -42,6 +42,12 @@ typedef ulonglong sql_mode_t;
 #define QUERY_CACHE_DEF_QUERY_HASH_SIZE		1024
 #define QUERY_CACHE_DEF_TABLE_HASH_SIZE		1024
 
+/*
+  number of slots of the lock-free filters of cached queries and tables
+  (see at Query_cache::filter_add (sql_cache.cc))
+*/
+#define QUERY_CACHE_FILTER_SLOTS		4096
+
 /* minimal result data size when data allocated */
 #define QUERY_CACHE_MIN_RESULT_DATA_SIZE	1024*4
 
@@ -328,6 +334,15 @@ protected:
   Query_cache_memory_bin *bins;			// free block lists
   Query_cache_memory_bin_step *steps;		// bins spacing info
   HASH queries, tables;
+  /*
+    Number of cached queries, and of tables used by cached queries, whose
+    key falls in each slot. They are changed under structure_guard_mutex
+    but read without it, so that lookups of queries which are not cached
+    and invalidations of tables which are not used by any cached query
+    don't wait for the mutex.
+  */
+  volatile int32 query_filter[QUERY_CACHE_FILTER_SLOTS];
+  volatile int32 table_filter[QUERY_CACHE_FILTER_SLOTS];
   /* options */
   ulong min_allocation_unit, min_result_data_size;
   uint def_query_hash_size, def_table_hash_size;
@@ -345,6 +360,13 @@ protected:
   static void double_linked_list_join(Query_cache_block *head_tail,
 				      Query_cache_block *tail_head);
 
+  /* Lock-free filters of cached queries and tables */
+  static void filter_add(volatile int32 *filter, const CHARSET_INFO *cs,
+                         const uchar *key, size_t key_length, int32 count);
+  static bool filter_may_contain(volatile int32 *filter,
+                                 const CHARSET_INFO *cs,
+                                 const uchar *key, size_t key_length);
+
   /* Table key generation */
   static size_t filename_2_table_key (char *key, const char *filename,
                                       size_t *db_length);
@@ -1848,6 +1848,7 @@ void THD::cleanup_connection(void)
   cleanup_done= 0;
   init();
   stmt_map.reset();
+  parse_cache.reset();
   my_hash_init(&user_vars, system_charset_info, USER_VARS_HASH_SIZE, 0, 0,
                (my_hash_get_key) get_var_key,
                (my_hash_free_key) free_user_var, 0,
@@ -2021,6 +2022,7 @@ void THD::release_resources()
   mysql_mutex_unlock(&LOCK_thd_query);
 
   stmt_map.reset();                     /* close all prepared statements */
+  parse_cache.reset();
   if (!cleanup_done)
     cleanup();
 
@@ -4381,6 +4383,8 @@ void THD::clear_slow_extended()
   tmp_tables_used=              0;
   tmp_tables_disk_used=         0;
   tmp_tables_size=              0;
+  sort_spill_bytes=             0;
+  sort_spill_disk_bytes=        0;
   innodb_was_used=              false;
   if (!(server_status & SERVER_STATUS_IN_TRANS))
     innodb_trx_id=                0;
@@ -4402,6 +4406,8 @@ void THD::reset_sub_statement_state_slow_extended(Sub_statement_state *backup)
   backup->tmp_tables_used=              tmp_tables_used;
   backup->tmp_tables_disk_used=         tmp_tables_disk_used;
   backup->tmp_tables_size=              tmp_tables_size;
+  backup->sort_spill_bytes=             sort_spill_bytes;
+  backup->sort_spill_disk_bytes=        sort_spill_disk_bytes;
   backup->innodb_was_used=              innodb_was_used;
   backup->innodb_io_reads=              innodb_io_reads;
   backup->innodb_io_read=               innodb_io_read;
@@ -4421,6 +4427,8 @@ void THD::restore_sub_statement_state_slow_extended(const Sub_statement_state *b
   tmp_tables_used+=              backup->tmp_tables_used;
   tmp_tables_disk_used+=         backup->tmp_tables_disk_used;
   tmp_tables_size+=              backup->tmp_tables_size;
+  sort_spill_bytes+=             backup->sort_spill_bytes;
+  sort_spill_disk_bytes+=        backup->sort_spill_disk_bytes;
   innodb_was_used=               (innodb_was_used || backup->innodb_was_used);
   innodb_io_reads+=              backup->innodb_io_reads;
   innodb_io_read+=               backup->innodb_io_read;
@@ -5084,6 +5092,7 @@ void THD::claim_memory_ownership()
 #endif /* defined(ENABLED_DEBUG_SYNC) */
   get_transaction()->claim_memory_ownership();
   stmt_map.claim_memory_ownership();
+  parse_cache.claim_memory_ownership();
 #endif /* HAVE_PSI_MEMORY_INTERFACE */
 }
 
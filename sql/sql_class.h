@@ -459,6 +459,7 @@ typedef struct system_variables
 
   ulonglong max_heap_table_size;
   ulonglong tmp_table_size;
+  ulong internal_tmp_mem_row_format;
   ulonglong long_query_time;
   my_bool end_markers_in_json;
   /* A bitmap for switching optimizations on/off */
@@ -497,20 +498,25 @@ typedef struct system_variables
   ulong net_write_timeout;
   ulong optimizer_prune_level;
   ulong optimizer_search_depth;
+  ulong parse_cache_size;
   ulonglong parser_max_mem_size;
   ulong range_optimizer_max_mem_size;
   ulong preload_buff_size;
   ulong profiling_history_size;
+  ulong protocol_compression_level;
   ulong read_buff_size;
   ulong read_rnd_buff_size;
   ulong div_precincrement;
   ulong sortbuff_size;
+  ulong sort_threads;
+  my_bool sort_spill_compression;
   ulong max_sp_recursion_depth;
   ulong default_week_format;
   ulong max_seeks_for_key;
   ulong range_alloc_block_size;
   ulong query_alloc_block_size;
   ulong query_prealloc_size;
+  ulong query_alloc_keep_size;
   ulong trans_alloc_block_size;
   ulong trans_prealloc_size;
   ulong group_concat_max_len;
@@ -676,6 +682,12 @@ typedef struct system_status_var
   ulonglong filesort_range_count;
   ulonglong filesort_rows;
   ulonglong filesort_scan_count;
+  /* Join orders reused from and searched for the plan cache. */
+  ulonglong plan_cache_hits;
+  ulonglong plan_cache_misses;
+  /* Queries executed from and prepared for the parse cache. */
+  ulonglong parse_cache_hits;
+  ulonglong parse_cache_misses;
   /* Prepared statements and binary protocol. */
   ulonglong com_stmt_prepare;
   ulonglong com_stmt_reprepare;
@@ -908,6 +920,71 @@ private:
 };
 
 
+struct Parse_cache_entry;
+
+/**
+  Prepared statements of a connection kept for the text of its queries
+  with the literals replaced by parameter markers.
+
+  A query whose text, with the literals replaced, is found in the cache
+  is executed with the cached statement, using the literals as parameter
+  values, instead of being parsed again. The cache holds at most
+  parse_cache_size statements; the least recently used ones are deleted
+  to make room for new ones.
+
+  These statements are not visible to the client, but they are counted in
+  prepared_stmt_count: no statement is added to the cache while
+  max_prepared_stmt_count is reached.
+*/
+
+class Parse_cache
+{
+public:
+  Parse_cache();
+
+  /**
+    Find the statement for the current query of the connection. If the
+    query is not in the cache yet, prepare the statement and add it.
+    The literals of the query are assigned to the parameters of the
+    statement.
+
+    @return the statement to execute the query with, or NULL if the
+            query must be parsed as usual
+  */
+  Prepared_statement *find(THD *thd);
+
+  /** Execute the current query with the statement returned by find(). */
+  bool execute(THD *thd, Prepared_statement *statement);
+
+  void claim_memory_ownership();
+
+  /** Delete all statements. */
+  void reset();
+
+  ~Parse_cache();
+private:
+  /** Entries of the cache, the most recently used first */
+  struct Lru_list
+  {
+    Parse_cache_entry *first, *last;
+    ulong count;
+  };
+
+  void link_first(Lru_list *list, Parse_cache_entry *entry);
+  void unlink(Lru_list *list, Parse_cache_entry *entry);
+  void evict(Lru_list *list);
+
+  HASH m_hash;
+  /** Entries with statements, at most parse_cache_size */
+  Lru_list m_statements;
+  /**
+    Entries for texts that can't be prepared as statements of the cache,
+    at most parse_cache_size
+  */
+  Lru_list m_failures;
+};
+
+
 /**
   A registry for item tree transformations performed during
   query optimization. We register only those changes which require
@@ -1152,6 +1229,8 @@ public:
   ulong      tmp_tables_used;
   ulong      tmp_tables_disk_used;
   ulonglong  tmp_tables_size;
+  ulonglong  sort_spill_bytes;
+  ulonglong  sort_spill_disk_bytes;
 
   bool       innodb_was_used;
   ulong      innodb_io_reads;
@@ -1838,6 +1917,8 @@ public:
 
   /** All prepared statements of this connection. */
   Prepared_statement_map stmt_map;
+  /** Statements prepared for the queries of this connection. */
+  Parse_cache parse_cache;
   /*
     A pointer to the stack frame of handle_one_connection(),
     which is called first in the thread for handling a client
@@ -2088,6 +2169,12 @@ public:
   ulong      tmp_tables_used;
   ulong      tmp_tables_disk_used;
   ulonglong  tmp_tables_size;
+  /*
+    Variables sort_spill_*** collect statistics about the records that
+    filesort and Unique wrote to temporary files
+  */
+  ulonglong  sort_spill_bytes;
+  ulonglong  sort_spill_disk_bytes;
   /*
     Variable innodb_was_used shows used or not InnoDB engine in current query.
   */
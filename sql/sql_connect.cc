@@ -1430,7 +1430,23 @@ static void prepare_new_connection_state(THD* thd)
   Security_context *sctx= thd->security_context();
 
   if (thd->get_protocol()->has_client_capability(CLIENT_COMPRESS))
+  {
     net->compress=1;        // Use compression
+#ifdef HAVE_COMPRESS
+    /*
+      Other clients use the bit of CLIENT_COMPRESS_LZ4 for something else,
+      it is only ours when the server has offered it.
+    */
+    if (opt_protocol_compression_lz4 &&
+        thd->get_protocol()->has_client_capability(CLIENT_COMPRESS_LZ4) &&
+        my_net_set_compression_lz4(net,
+                                   thd->variables.protocol_compression_level))
+    {
+      thd->killed= THD::KILL_CONNECTION;
+      return;
+    }
+#endif
+  }
 
   // Initializing session system variables.
   alloc_and_copy_thd_dynamic_variables(thd, true);
@@ -301,7 +301,12 @@
 #define OPTIMIZER_SWITCH_USE_INDEX_EXTENSIONS      (1ULL << 16)
 #define OPTIMIZER_SWITCH_COND_FANOUT_FILTER        (1ULL << 17)
 #define OPTIMIZER_SWITCH_DERIVED_MERGE             (1ULL << 18)
-#define OPTIMIZER_SWITCH_LAST                      (1ULL << 19)
+#define OPTIMIZER_SWITCH_HASH_JOIN                 (1ULL << 19)
+#define OPTIMIZER_SWITCH_HASH_GROUP_BY             (1ULL << 20)
+#define OPTIMIZER_SWITCH_DERIVED_STREAMING         (1ULL << 21)
+#define OPTIMIZER_SWITCH_PLAN_CACHE                (1ULL << 22)
+#define OPTIMIZER_SWITCH_COMPILED_CONDITIONS       (1ULL << 23)
+#define OPTIMIZER_SWITCH_LAST                      (1ULL << 24)
 
 #define OPTIMIZER_SWITCH_DEFAULT (OPTIMIZER_SWITCH_INDEX_MERGE | \
                                   OPTIMIZER_SWITCH_INDEX_MERGE_UNION | \
@@ -305,7 +305,7 @@ bool TABLE_LIST::materialize_derived(THD *thd)
   SELECT_LEX_UNIT *const unit= derived_unit();
   bool res= false;
 
-  DBUG_ASSERT(table && table->is_created());
+  DBUG_ASSERT(table && (table->is_created() || derived_result->stream_tab));
 
   if (unit->is_union())
   {
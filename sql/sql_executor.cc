@@ -36,6 +36,7 @@
 #include "sql_optimizer.h"    // JOIN
 #include "sql_show.h"         // get_schema_tables_result
 #include "sql_tmp_table.h"    // create_tmp_table
+#include "sql_union.h"        // Query_result_union
 #include "json_dom.h"    // Json_wrapper
 
 #include <algorithm>
@@ -52,11 +53,15 @@ evaluate_join_record(JOIN *join, QEP_TAB *qep_tab);
 static enum_nested_loop_state
 evaluate_null_complemented_join_record(JOIN *join, QEP_TAB *qep_tab);
 static enum_nested_loop_state
+stream_derived(JOIN *join, QEP_TAB *qep_tab);
+static enum_nested_loop_state
 end_send(JOIN *join, QEP_TAB *qep_tab, bool end_of_records);
 static enum_nested_loop_state
 end_write(JOIN *join, QEP_TAB *qep_tab, bool end_of_records);
 static enum_nested_loop_state
 end_update(JOIN *join, QEP_TAB *qep_tab, bool end_of_records);
+static enum_nested_loop_state
+end_update_hash(JOIN *join, QEP_TAB *qep_tab, bool end_of_records);
 static void copy_sum_funcs(Item_sum **func_ptr, Item_sum **end_ptr);
 
 static int read_system(TABLE *table);
@@ -774,6 +779,47 @@ return_zero_rows(JOIN *join, List<Item> &fields)
 }
 
 
+/**
+  Check whether the groups of a tmp table can be accumulated in a
+  Hash_group_table by end_update_hash().
+
+  The groups are compared by value in the tmp table's record, so every
+  group column must have a field there, and the record must not refer to
+  memory outside itself, as blobs do. The aggregate functions must be
+  ones that keep all of their state in the record.
+*/
+
+static bool use_hash_group_by(JOIN *join, TABLE *table,
+                              Temp_table_param *tmp_tbl)
+{
+  if (!join->thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_GROUP_BY) ||
+      table->hash_field || table->s->blob_fields ||
+      tmp_tbl->outer_sum_func_count)
+    return false;
+
+  for (ORDER *group= table->group; group; group= group->next)
+  {
+    if (!(*group->item)->get_tmp_table_field())
+      return false;
+  }
+
+  for (Item_sum **func_ptr= join->sum_funcs; *func_ptr; func_ptr++)
+  {
+    switch ((*func_ptr)->sum_func()) {
+    case Item_sum::COUNT_FUNC:
+    case Item_sum::SUM_FUNC:
+    case Item_sum::AVG_FUNC:
+    case Item_sum::MIN_FUNC:
+    case Item_sum::MAX_FUNC:
+      break;
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+
 /**
   @brief Setup write_func of QEP_tmp_table object
 
@@ -802,8 +848,17 @@ void setup_tmptable_write_func(QEP_TAB *tab)
     */
     if (table->s->keys)
     {
-      DBUG_PRINT("info",("Using end_update"));
-      op->set_write_func(end_update);
+      if (use_hash_group_by(join, table, tmp_tbl))
+      {
+        DBUG_PRINT("info",("Using end_update_hash"));
+        op->hash_groups()->init(table->s->reclength);
+        op->set_write_func(end_update_hash);
+      }
+      else
+      {
+        DBUG_PRINT("info",("Using end_update"));
+        op->set_write_func(end_update);
+      }
     }
   }
   else if (join->sort_and_group && !tmp_tbl->precomputed_group_by)
@@ -1220,6 +1275,9 @@ sub_select(JOIN *join, QEP_TAB *const qep_tab,bool end_of_records)
       (*qep_tab->next_select)(join,qep_tab+1,end_of_records);
     DBUG_RETURN(nls);
   }
+  if (qep_tab->streamed)
+    DBUG_RETURN(stream_derived(join, qep_tab));
+
   READ_RECORD *info= &qep_tab->read_record;
 
   if (qep_tab->prepare_scan())
@@ -1452,6 +1510,304 @@ static int do_sj_reset(SJ_TMP_TABLE *sj_tbl)
   DBUG_RETURN(0);
 }
 
+/**
+  Condition_program::Step::accept of a comparison of a column with a
+  constant.
+*/
+
+static uint comparison_accept_mask(Item_func::Functype functype,
+                                   bool const_on_left)
+{
+  uint accept;
+  switch (functype) {
+  case Item_func::EQ_FUNC:
+    accept= 2;
+    break;
+  case Item_func::NE_FUNC:
+    accept= 5;
+    break;
+  case Item_func::LT_FUNC:
+    accept= 1;
+    break;
+  case Item_func::LE_FUNC:
+    accept= 3;
+    break;
+  case Item_func::GT_FUNC:
+    accept= 4;
+    break;
+  case Item_func::GE_FUNC:
+    accept= 6;
+    break;
+  default:
+    DBUG_ASSERT(false);
+    return 0;
+  }
+  /* <const> < <column> is <column> > <const> */
+  if (const_on_left)
+    accept= (accept & 2) | ((accept & 1) << 2) | ((accept & 4) >> 2);
+  return accept;
+}
+
+
+/**
+  Compile a comparison of a column with a constant. Other comparisons, and
+  comparisons that Arg_comparator does not do as integers or DATETIME
+  values, are evaluated as items.
+
+  @return true on error
+*/
+
+bool Condition_program::add_comparison(THD *thd, Item_func *func)
+{
+  const Arg_comparator *cmp=
+    down_cast<Item_bool_func2 *>(func)->get_comparator();
+  Item **field_arg= cmp->left();
+  Item **const_arg= cmp->right();
+  Step step;
+
+  step.opcode= OP_ITEM;
+  step.accept= 0;
+  step.item= func;
+  step.field= NULL;
+  step.value= 0;
+
+  const bool const_on_left= (*field_arg)->type() != Item::FIELD_ITEM;
+  if (const_on_left)
+    std::swap(field_arg, const_arg);
+
+  /*
+    The constant must have the same value for all rows. Item_cache objects
+    that are constant hold constant expressions cached by the optimizer;
+    user variables are not constant, as they may be assigned by the query.
+  */
+  if ((*field_arg)->type() != Item::FIELD_ITEM ||
+      !(cmp->is_cached_const(const_arg) ||
+        ((*const_arg)->const_item() &&
+         ((*const_arg)->basic_const_item() ||
+          (*const_arg)->type() == Item::CACHE_ITEM))))
+    return m_steps.push_back(step);
+
+  Field *const field= down_cast<Item_field *>(*field_arg)->field;
+  bool is_null;
+
+  if (cmp->compares_as_int())
+  {
+    switch (field->type()) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+      break;
+    default:
+      return m_steps.push_back(step);
+    }
+    step.value= (*const_arg)->val_int();
+    is_null= (*const_arg)->null_value;
+
+    /*
+      Compare as the type of the column. A constant of the other
+      signedness must be in the range of both types.
+    */
+    const bool is_unsigned= (*field_arg)->unsigned_flag;
+    if (is_unsigned != (*const_arg)->unsigned_flag && step.value < 0)
+      return m_steps.push_back(step);
+    step.opcode= is_unsigned ? OP_UINT_CMP : OP_INT_CMP;
+  }
+  else if (cmp->compares_as_datetime() &&
+           (*field_arg)->is_temporal_with_date())
+  {
+    /* As compare_datetime() gets the value, but without caching it */
+    Item **arg= const_arg;
+    step.value= get_datetime_value(thd, &arg, NULL, *field_arg, &is_null);
+    step.opcode= OP_DATETIME_CMP;
+  }
+  else
+    return m_steps.push_back(step);
+
+  if (thd->is_error())
+    return true;
+  if (is_null)
+  {
+    /* Comparisons with NULL are never true */
+    m_always_false= true;
+    return false;
+  }
+  step.accept= comparison_accept_mask(func->functype(), const_on_left);
+  step.item= NULL;
+  step.field= field;
+  return m_steps.push_back(step);
+}
+
+
+/**
+  Compile the conjuncts of a condition.
+
+  @return true on error
+*/
+
+bool Condition_program::add_conjuncts(THD *thd, Item *cond)
+{
+  if (cond->type() == Item::COND_ITEM &&
+      down_cast<Item_cond *>(cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    List_iterator<Item> it(*down_cast<Item_cond *>(cond)->argument_list());
+    Item *item;
+    while ((item= it++))
+    {
+      if (add_conjuncts(thd, item))
+        return true;
+    }
+    return false;
+  }
+
+  if (cond->const_item() &&
+      (cond->basic_const_item() || cond->type() == Item::CACHE_ITEM))
+  {
+    /* Fold the constant */
+    if (!cond->val_int())
+      m_always_false= true;
+    return thd->is_error();
+  }
+
+  if (cond->type() == Item::FUNC_ITEM)
+  {
+    Item_func *const func= down_cast<Item_func *>(cond);
+    switch (func->functype()) {
+    case Item_func::EQ_FUNC:
+    case Item_func::NE_FUNC:
+    case Item_func::LT_FUNC:
+    case Item_func::LE_FUNC:
+    case Item_func::GT_FUNC:
+    case Item_func::GE_FUNC:
+      return add_comparison(thd, func);
+    case Item_func::ISNULL_FUNC:
+    case Item_func::ISNOTNULL_FUNC:
+      /* Item_func_isnull caches its value if the argument can't be NULL */
+      if (func->arguments()[0]->type() == Item::FIELD_ITEM &&
+          !func->const_item())
+      {
+        Step step;
+        step.opcode= func->functype() == Item_func::ISNULL_FUNC ?
+          OP_FIELD_IS_NULL : OP_FIELD_IS_NOT_NULL;
+        step.accept= 0;
+        step.item= NULL;
+        step.field= down_cast<Item_field *>(func->arguments()[0])->field;
+        step.value= 0;
+        return m_steps.push_back(step);
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  Step step;
+  step.opcode= OP_ITEM;
+  step.accept= 0;
+  step.item= cond;
+  step.field= NULL;
+  step.value= 0;
+  return m_steps.push_back(step);
+}
+
+
+bool Condition_program::compile(THD *thd, Item *condition)
+{
+  m_condition= NULL;
+  m_steps.clear();
+  m_always_false= false;
+
+  if (add_conjuncts(thd, condition))
+    return true;
+  m_condition= condition;
+  return false;
+}
+
+
+bool Condition_program::is_true() const
+{
+  if (m_always_false)
+    return false;
+
+  for (const Step *step= m_steps.begin(); step != m_steps.end(); ++step)
+  {
+    longlong value;
+    uint result;
+
+    switch (step->opcode) {
+    case OP_ITEM:
+      if (!step->item->val_int())
+        return false;
+      continue;
+    case OP_FIELD_IS_NULL:
+      if (!step->field->is_null())
+        return false;
+      continue;
+    case OP_FIELD_IS_NOT_NULL:
+      if (step->field->is_null())
+        return false;
+      continue;
+    case OP_INT_CMP:
+      if (step->field->is_null())
+        return false;
+      value= step->field->val_int();
+      result= value < step->value ? 1 : (value == step->value ? 2 : 4);
+      break;
+    case OP_UINT_CMP:
+      if (step->field->is_null())
+        return false;
+      value= step->field->val_int();
+      result= static_cast<ulonglong>(value) <
+              static_cast<ulonglong>(step->value) ? 1 :
+              (value == step->value ? 2 : 4);
+      break;
+    case OP_DATETIME_CMP:
+      if (step->field->is_null())
+        return false;
+      value= step->field->val_date_temporal();
+      result= value < step->value ? 1 : (value == step->value ? 2 : 4);
+      break;
+    default:
+      DBUG_ASSERT(false);
+      return false;
+    }
+    if (!(step->accept & result))
+      return false;
+  }
+  return true;
+}
+
+
+/**
+  Evaluate the condition attached to a table. With optimizer_switch
+  compiled_conditions, the condition is compiled when first evaluated and
+  the program is used as long as the condition is attached to the table.
+
+  @return true if the condition is true for the current row
+*/
+
+static bool evaluate_condition(THD *thd, QEP_TAB *tab)
+{
+  Item *const condition= tab->condition();
+
+  if (!thd->optimizer_switch_flag(OPTIMIZER_SWITCH_COMPILED_CONDITIONS))
+    return condition->val_int() != 0;
+
+  Condition_program *program= tab->condition_program;
+  if (program == NULL || program->condition() != condition)
+  {
+    if (program == NULL &&
+        !(program= tab->condition_program=
+          new (thd->mem_root) Condition_program(thd->mem_root)))
+      return condition->val_int() != 0;
+    if (program->compile(thd, condition))
+      return condition->val_int() != 0;
+  }
+  return program->is_true();
+}
+
+
 /**
   @brief Process one row of the nested loop join.
 
@@ -1483,7 +1839,7 @@ evaluate_join_record(JOIN *join, QEP_TAB *const qep_tab)
 
   if (condition)
   {
-    found= MY_TEST(condition->val_int());
+    found= evaluate_condition(join->thd, qep_tab);
 
     if (join->thd->killed)
     {
@@ -1535,7 +1891,7 @@ evaluate_join_record(JOIN *join, QEP_TAB *const qep_tab)
         DBUG_ASSERT(!(tab->table()->reginfo.not_exists_optimize &&
                      !tab->condition()));
 
-        if (tab->condition() && !tab->condition()->val_int())
+        if (tab->condition() && !evaluate_condition(join->thd, tab))
         {
           /* The condition attached to table tab is false */
 
@@ -2503,6 +2859,90 @@ int join_materialize_derived(QEP_TAB *tab)
 }
 
 
+/**
+  Join the rows of a streamed derived table as its query expression
+  produces them, @see QEP_TAB::streamed.
+
+  The query expression is executed with the derived table's
+  Query_result_union pointing at qep_tab, so that every row it stores in
+  the derived table's record buffer is passed to stream_derived_record()
+  instead of being written to the temporary table, which is never
+  instantiated.
+
+  @param join    the join
+  @param qep_tab the streamed derived table, the first non-const table of
+                 the join
+
+  @return Nested loop state
+*/
+
+static enum_nested_loop_state
+stream_derived(JOIN *join, QEP_TAB *const qep_tab)
+{
+  DBUG_ENTER("stream_derived");
+  THD *const thd= join->thd;
+  TABLE_LIST *const derived= qep_tab->table_ref;
+  Query_result_union *const result= derived->derived_result;
+
+  DBUG_ASSERT(derived->uses_materialization() &&
+              !qep_tab->table()->is_created());
+
+  join->return_tab= qep_tab->idx();
+  qep_tab->not_null_compl= true;
+  qep_tab->found_match= false;
+  qep_tab->stream_state= NESTED_LOOP_OK;
+  thd->get_stmt_da()->reset_current_row_for_condition();
+
+  result->stream_tab= qep_tab;
+  bool res= derived->materialize_derived(thd);
+  result->stream_tab= NULL;
+  res|= derived->cleanup_derived();
+
+  /*
+    The query expression stops with an error status when the outer join
+    asks for no more rows (LIMIT reached, query killed, jump back to a
+    preceding table...): report the state of the outer join instead.
+  */
+  if (qep_tab->stream_state != NESTED_LOOP_OK)
+    DBUG_RETURN(qep_tab->stream_state);
+  if (thd->is_error() || (res && join->return_tab >= qep_tab->idx()))
+    DBUG_RETURN(NESTED_LOOP_ERROR);
+  DBUG_RETURN(NESTED_LOOP_OK);
+}
+
+
+/**
+  Join one row of a streamed derived table with the remaining tables of
+  the outer join. Called by Query_result_union::send_data() once the row
+  has been stored in the record buffer of the derived table.
+
+  @param qep_tab the streamed derived table
+
+  @return false to continue producing rows, true to stop
+*/
+
+bool stream_derived_record(QEP_TAB *qep_tab)
+{
+  JOIN *const join= qep_tab->join();
+  THD *const thd= join->thd;
+
+  if (thd->killed)
+  {
+    thd->send_kill_message();
+    qep_tab->stream_state= NESTED_LOOP_KILLED;
+    return true;
+  }
+
+  // Evaluate the outer join in the context of its own query block
+  SELECT_LEX *const save_current_select= thd->lex->current_select();
+  thd->lex->set_current_select(join->select_lex);
+  qep_tab->stream_state= evaluate_join_record(join, qep_tab);
+  thd->lex->set_current_select(save_current_select);
+
+  return qep_tab->stream_state != NESTED_LOOP_OK ||
+         join->return_tab < qep_tab->idx();
+}
+
 
 /*
   Helper function for materialization of a semi-joined subquery.
@@ -3515,6 +3955,232 @@ end_update(JOIN *join, QEP_TAB *const qep_tab, bool end_of_records)
 }
 
 
+uchar *Hash_group_table::find(ulonglong hash, ORDER *group,
+                              uchar *record) const
+{
+  if (!m_count)
+    return NULL;
+  const size_t mask= m_slot_count - 1;
+  for (size_t i= static_cast<size_t>(hash) & mask; m_slots[i].group;
+       i= (i + 1) & mask)
+  {
+    if (m_slots[i].hash == hash &&
+        !group_rec_cmp(group, record, group_record(m_slots[i].group)))
+      return group_record(m_slots[i].group);
+  }
+  return NULL;
+}
+
+
+/** Double the hash slots, or allocate them if there are none. */
+
+bool Hash_group_table::grow()
+{
+  const size_t slot_count= m_slot_count ? m_slot_count * 2 : MIN_SLOT_COUNT;
+  Slot *slots= (Slot *) my_malloc(key_memory_TABLE,
+                                  slot_count * sizeof(Slot),
+                                  MYF(MY_WME | MY_ZEROFILL));
+  if (!slots)
+    return true;
+
+  const size_t mask= slot_count - 1;
+  for (Group *group= m_first; group; group= group->next)
+  {
+    size_t i= static_cast<size_t>(group->hash) & mask;
+    while (slots[i].group)
+      i= (i + 1) & mask;
+    slots[i].hash= group->hash;
+    slots[i].group= group;
+  }
+  my_free(m_slots);
+  m_slots= slots;
+  m_slot_count= slot_count;
+  return false;
+}
+
+
+uchar *Hash_group_table::insert(ulonglong hash, const uchar *record)
+{
+  // Keep the load factor at most 1/2
+  if ((m_count + 1) * 2 > m_slot_count && grow())
+    return NULL;
+
+  if (!m_mem_root_inited)
+  {
+    init_sql_alloc(key_memory_TABLE, &m_mem_root,
+                   ALLOC_ROOT_MIN_BLOCK_SIZE * 64, 0);
+    m_mem_root_inited= true;
+  }
+  Group *group= (Group *) alloc_root(&m_mem_root,
+                                     GROUP_HEADER_SIZE + m_record_length);
+  if (!group)
+    return NULL;
+  group->next= NULL;
+  group->hash= hash;
+  memcpy(group_record(group), record, m_record_length);
+
+  const size_t mask= m_slot_count - 1;
+  size_t i= static_cast<size_t>(hash) & mask;
+  while (m_slots[i].group)
+    i= (i + 1) & mask;
+  m_slots[i].hash= hash;
+  m_slots[i].group= group;
+
+  if (m_last)
+    m_last->next= group;
+  else
+    m_first= group;
+  m_last= group;
+  m_count++;
+  return group_record(group);
+}
+
+
+void Hash_group_table::reset()
+{
+  if (m_count)
+  {
+    memset(m_slots, 0, m_slot_count * sizeof(Slot));
+    free_root(&m_mem_root, MYF(MY_MARK_BLOCKS_FREE));
+  }
+  m_count= 0;
+  m_first= m_last= NULL;
+}
+
+
+void Hash_group_table::free()
+{
+  my_free(m_slots);
+  m_slots= NULL;
+  m_slot_count= 0;
+  if (m_mem_root_inited)
+  {
+    free_root(&m_mem_root, MYF(0));
+    m_mem_root_inited= false;
+  }
+  m_count= 0;
+  m_first= m_last= NULL;
+}
+
+
+/**
+  Write the groups accumulated by end_update_hash() to the tmp table.
+
+  The tmp table is converted to an on-disk table if it gets full, in which
+  case an index scan is started on the new table, as end_update() expects.
+
+  @returns
+    false  ok
+    true   error
+*/
+
+static bool write_hash_groups(JOIN *join, QEP_TAB *const qep_tab)
+{
+  TABLE *const table= qep_tab->table();
+  Temp_table_param *const tmp_tbl= qep_tab->tmp_table_param;
+  Hash_group_table *const groups=
+    static_cast<QEP_tmp_table *>(qep_tab->op)->hash_groups();
+  int error;
+
+  for (uchar *group= groups->first(); group; group= groups->next(group))
+  {
+    memcpy(table->record[0], group, table->s->reclength);
+    if ((error= table->file->ha_write_row(table->record[0])))
+    {
+      if (create_ondisk_from_heap(join->thd, table,
+                                  tmp_tbl->start_recinfo,
+                                  &tmp_tbl->recinfo,
+                                  error, FALSE, NULL))
+        return true;                  // Not a table_is_full error
+      if ((error= table->file->ha_index_init(0, 0)))
+      {
+        table->file->print_error(error, MYF(0));
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+
+/* ARGSUSED */
+/**
+  Group by looking up the group record in a hash table in memory.
+
+  Works as end_update(), but the groups are accumulated in the
+  Hash_group_table of the QEP_tmp_table, and are only written to the tmp
+  table at the end. This saves an index lookup and a row update in the
+  storage engine for every input record.
+
+  If the groups take more memory than an in-memory tmp table is allowed,
+  they are written to the tmp table, and end_update() becomes the write
+  function: the remaining records are grouped through the index of the
+  tmp table.
+*/
+
+static enum_nested_loop_state
+end_update_hash(JOIN *join, QEP_TAB *const qep_tab, bool end_of_records)
+{
+  TABLE *const table= qep_tab->table();
+  Temp_table_param *const tmp_tbl= qep_tab->tmp_table_param;
+  Hash_group_table *const groups=
+    static_cast<QEP_tmp_table *>(qep_tab->op)->hash_groups();
+  DBUG_ENTER("end_update_hash");
+
+  if (end_of_records)
+  {
+    const bool error= write_hash_groups(join, qep_tab);
+    groups->reset();
+    DBUG_RETURN(error ? NESTED_LOOP_ERROR : NESTED_LOOP_OK);
+  }
+  if (join->thd->killed)			// Aborted by user
+  {
+    join->thd->send_kill_message();
+    DBUG_RETURN(NESTED_LOOP_KILLED);             /* purecov: inspected */
+  }
+
+  join->found_records++;
+  if (copy_fields(tmp_tbl, join->thd))
+    DBUG_RETURN(NESTED_LOOP_ERROR);           /* purecov: inspected */
+  /*
+    The group columns are compared in the tmp table's record, so functions
+    in the GROUP BY list must be evaluated for every record, as with
+    hash_field in end_update().
+  */
+  if (copy_funcs(tmp_tbl->items_to_copy, join->thd))
+    DBUG_RETURN(NESTED_LOOP_ERROR);           /* purecov: inspected */
+
+  const ulonglong hash= unique_hash_group(table->group);
+  uchar *group= groups->find(hash, table->group, table->record[0]);
+  if (group)
+  {
+    /* Update the group in place */
+    memcpy(table->record[0], group, table->s->reclength);
+    update_tmptable_sum_func(join->sum_funcs, table);
+    memcpy(group, table->record[0], table->s->reclength);
+    DBUG_RETURN(NESTED_LOOP_OK);
+  }
+
+  init_tmptable_sum_functions(join->sum_funcs);
+  if (!groups->insert(hash, table->record[0]))
+    DBUG_RETURN(NESTED_LOOP_ERROR);           /* purecov: inspected */
+  qep_tab->send_records++;
+
+  const ulonglong max_memory=
+    std::min(join->thd->variables.tmp_table_size,
+             join->thd->variables.max_heap_table_size);
+  if (groups->memory_used() > max_memory)
+  {
+    /* Continue grouping in the tmp table */
+    if (write_hash_groups(join, qep_tab))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+    groups->reset();
+    static_cast<QEP_tmp_table *>(qep_tab->op)->set_write_func(end_update);
+  }
+  DBUG_RETURN(NESTED_LOOP_OK);
+}
+
+
 	/* ARGSUSED */
 enum_nested_loop_state
 end_write_group(JOIN *join, QEP_TAB *const qep_tab, bool end_of_records)
@@ -3769,8 +4435,8 @@ QEP_TAB::remove_duplicates()
 
   free_io_cache(tbl);				// Safety
   tbl->file->info(HA_STATUS_VARIABLE);
-  if (tbl->s->db_type() == heap_hton ||
-      (!tbl->s->blob_fields &&
+  if (!tbl->s->blob_fields &&
+      (tbl->s->db_type() == heap_hton ||
        ((ALIGN_SIZE(reclength) + HASH_OVERHEAD) * tbl->file->stats.records <
 	join()->thd->variables.sortbuff_size)))
     error=remove_dup_with_hash_index(join()->thd, tbl,
@@ -4607,6 +5273,7 @@ QEP_tmp_table::prepare_tmp_table()
     (void) table->file->extra(HA_EXTRA_WRITE_CACHE);
     empty_record(table);
   }
+  m_hash_groups.reset();
   /* If it wasn't already, start index scan for grouping using table index. */
   if (!table->file->inited &&
       ((table->group &&
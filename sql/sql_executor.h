@@ -217,6 +217,162 @@ public:
 };
 
 
+/**
+  In-memory hash table of the groups of a GROUP BY, used by
+  end_update_hash() instead of the index of the tmp table.
+
+  Each group is a copy of the tmp table's record[0] holding the group
+  columns and the running values of the aggregate functions. The groups
+  are chained in insertion order, so that they are written to the tmp
+  table in the same order as end_update() would have written them.
+*/
+
+class Hash_group_table
+{
+public:
+  Hash_group_table()
+    : m_slots(NULL), m_slot_count(0), m_count(0), m_first(NULL),
+      m_last(NULL), m_record_length(0), m_mem_root_inited(false)
+  {}
+  ~Hash_group_table() { free(); }
+
+  /** Set the length of the records to store. */
+  void init(size_t record_length) { m_record_length= record_length; }
+  /**
+    Find the group of a record.
+
+    @param hash    hash of the group columns, see unique_hash_group()
+    @param group   GROUP BY list of the tmp table
+    @param record  the tmp table's record[0]
+
+    @return the stored copy of the group, or NULL if not found
+  */
+  uchar *find(ulonglong hash, ORDER *group, uchar *record) const;
+  /**
+    Store a copy of a record as a new group.
+
+    @return the stored copy, or NULL if out of memory
+  */
+  uchar *insert(ulonglong hash, const uchar *record);
+  /** First group in insertion order, or NULL if empty */
+  uchar *first() const
+  { return m_first ? group_record(m_first) : NULL; }
+  /** Group stored after the given one, or NULL */
+  uchar *next(uchar *record) const
+  {
+    Group *const next_group= group_header(record)->next;
+    return next_group ? group_record(next_group) : NULL;
+  }
+  /** Number of bytes allocated for the groups and the hash slots */
+  ulonglong memory_used() const
+  {
+    return m_slot_count * sizeof(Slot) +
+      m_count * (GROUP_HEADER_SIZE + m_record_length);
+  }
+  /** Forget all groups, keeping the memory for reuse. */
+  void reset();
+  /** Free all memory. */
+  void free();
+
+private:
+  struct Group
+  {
+    Group *next;
+    ulonglong hash;
+  };
+  struct Slot
+  {
+    ulonglong hash;
+    Group *group;
+  };
+  static const size_t GROUP_HEADER_SIZE= ALIGN_SIZE(sizeof(Group));
+  static const size_t MIN_SLOT_COUNT= 1024;
+
+  static uchar *group_record(Group *group)
+  { return reinterpret_cast<uchar *>(group) + GROUP_HEADER_SIZE; }
+  static Group *group_header(uchar *record)
+  { return reinterpret_cast<Group *>(record - GROUP_HEADER_SIZE); }
+  bool grow();
+
+  /** Open addressing hash table of size m_slot_count, a power of two */
+  Slot *m_slots;
+  size_t m_slot_count;
+  size_t m_count;
+  Group *m_first, *m_last;
+  size_t m_record_length;
+  bool m_mem_root_inited;
+  MEM_ROOT m_mem_root;
+};
+
+
+/**
+  A condition attached to a table, compiled to a sequence of steps that
+  evaluate its conjuncts.
+
+  Comparisons of an integer or DATE/DATETIME/TIMESTAMP column with a
+  constant, and IS [NOT] NULL tests of a column, are evaluated by reading
+  the field directly and comparing with the constant value computed once
+  at compilation, instead of through the item tree and Arg_comparator.
+  Constant conjuncts are folded. Any other conjunct is a step that
+  evaluates its item.
+*/
+
+class Condition_program : public Sql_alloc
+{
+public:
+  explicit Condition_program(MEM_ROOT *mem_root)
+    : m_condition(NULL), m_steps(mem_root), m_always_false(false)
+  {}
+
+  /**
+    Compile a condition, replacing the previous program.
+
+    Must be called when the condition is first evaluated, since the
+    constants are evaluated here, as they would be by the first evaluation
+    of the condition.
+
+    @return true on error, in which case the condition must be evaluated
+            as an item
+  */
+  bool compile(THD *thd, Item *condition);
+  /** The condition compiled, or NULL */
+  Item *condition() const { return m_condition; }
+  /** Whether the condition is true for the current row */
+  bool is_true() const;
+
+private:
+  enum Opcode
+  {
+    OP_ITEM,             ///< Evaluate the item
+    OP_FIELD_IS_NULL,
+    OP_FIELD_IS_NOT_NULL,
+    OP_INT_CMP,          ///< Compare Field::val_int() as signed integers
+    OP_UINT_CMP,         ///< Compare Field::val_int() as unsigned integers
+    OP_DATETIME_CMP      ///< Compare Field::val_date_temporal()
+  };
+  struct Step
+  {
+    Opcode opcode;
+    /**
+      Accepted results of the comparison: bit 0 for less than the
+      constant, bit 1 for equal and bit 2 for greater
+    */
+    uint accept;
+    Item *item;
+    Field *field;
+    longlong value;
+  };
+
+  bool add_conjuncts(THD *thd, Item *cond);
+  bool add_comparison(THD *thd, Item_func *func);
+
+  Item *m_condition;
+  Mem_root_array<Step, true> m_steps;
+  /** A conjunct is always false or NULL */
+  bool m_always_false;
+};
+
+
 /**
   @brief
     Class for accumulating join result in a tmp table, grouping them if
@@ -231,6 +387,8 @@ public:
       end_update         Perform grouping using the key generated on tmp
                          table. Input records aren't expected to be sorted.
                          Tmp table uses the heap engine
+      end_update_hash    Same as above, but the groups are first accumulated
+                         in a Hash_group_table in memory.
       end_update_unique  Same as above, but the engine is myisam.
 
     Lazy table initialization is used - the table will be instantiated and
@@ -259,10 +417,14 @@ public:
   {
     write_func= new_write_func;
   }
+  Hash_group_table *hash_groups() { return &m_hash_groups; }
+  void mem_free() { m_hash_groups.free(); }
 
 private:
   /** Write function that would be used for saving records in tmp table. */
   Next_select_func write_func;
+  /** Groups accumulated by end_update_hash */
+  Hash_group_table m_hash_groups;
   enum_nested_loop_state put_record(bool end_of_records);
   MY_ATTRIBUTE((warn_unused_result))
   bool prepare_tmp_table();
@@ -304,6 +466,7 @@ int join_read_first(QEP_TAB *tab);
 int join_read_last(QEP_TAB *tab);
 int join_read_last_key(QEP_TAB *tab);
 int join_materialize_derived(QEP_TAB *tab);
+bool stream_derived_record(QEP_TAB *tab);
 int join_materialize_semijoin(QEP_TAB *tab);
 int join_read_prev_same(READ_RECORD *info);
 
@@ -350,6 +513,8 @@ public:
     not_null_compl(false),
     first_unmatched(NO_PLAN_IDX),
     materialized(false),
+    streamed(false),
+    stream_state(NESTED_LOOP_OK),
     materialize_table(NULL),
     read_first_record(NULL),
     next_select(NULL),
@@ -364,6 +529,7 @@ public:
     not_used_in_distinct(false),
     cache_idx_cond(NULL),
     having(NULL),
+    condition_program(NULL),
     op(NULL),
     tmp_table_param(NULL),
     filesort(NULL),
@@ -544,6 +710,15 @@ public:
   /// For a materializable derived or SJ table: true if has been materialized
   bool materialized;
 
+  /**
+    For a materializable derived table: true if its rows are joined as its
+    query expression produces them instead of being materialized first,
+    @see JOIN::prepare_result() and stream_derived_record().
+  */
+  bool streamed;
+  /// Outcome of joining the rows of a streamed derived table
+  enum_nested_loop_state stream_state;
+
   READ_RECORD::Setup_func materialize_table;
   /**
      Initialize table for reading and fetch the first row from the table. If
@@ -584,6 +759,9 @@ public:
   /** HAVING condition for checking prior saving a record into tmp table*/
   Item *having;
 
+  /** condition() compiled, see optimizer_switch compiled_conditions */
+  Condition_program *condition_program;
+
   QEP_operation *op;
 
   /* Tmp table info */
@@ -706,10 +706,193 @@ int JOIN_CACHE_BNL::init()
     }
   }
 
+  if (qep_tab->condition() &&
+      join->thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_JOIN))
+  {
+    /*
+      Look for an equality between a column of qep_tab->table() and a column
+      of one of the tables whose records are kept in this or the previous
+      join buffers. Only top-level conjuncts are considered: these must be
+      true for any match, so the hash table may be used as a filter while
+      check_match() still evaluates the whole condition.
+    */
+    table_map outer_map= 0;
+    for (JOIN_CACHE *cache= this; cache; cache= cache->prev_cache)
+    {
+      for (uint i= 1; i <= cache->tables; i++)
+        outer_map|= cache->qep_tab[-static_cast<int>(i)].table_ref->map();
+    }
+    const table_map inner_map= qep_tab->table_ref->map();
+    Item *const cond= qep_tab->condition();
+    if (cond->type() == Item::COND_ITEM &&
+        static_cast<Item_cond*>(cond)->functype() ==
+        Item_func::COND_AND_FUNC)
+    {
+      List_iterator<Item> li(*static_cast<Item_cond*>(cond)->argument_list());
+      Item *item;
+      while ((item= li++) &&
+             !get_hash_join_args(item, inner_map, outer_map,
+                                 &hash_inner_arg, &hash_outer_arg, &hash_cs))
+      {}
+    }
+    else
+      get_hash_join_args(cond, inner_map, outer_map,
+                         &hash_inner_arg, &hash_outer_arg, &hash_cs);
+
+    if (is_hashed())
+    {
+      Opt_trace_object trace_hash(&join->thd->opt_trace,
+                                  "hash_join_in_bnl");
+      trace_hash.add("inner", hash_inner_arg).
+        add("outer", hash_outer_arg);
+    }
+  }
+
   DBUG_RETURN(0);
 }
 
 
+/*
+  Check whether a column can be used as a hash join key
+
+  SYNOPSIS
+    hash_join_key_type()
+      field   the column
+      type    OUT: INT_RESULT if the values are hashed as integers,
+              STRING_RESULT if they are hashed as strings
+
+  DESCRIPTION
+    Only integer and character string columns are accepted: for them two
+    values are equal exactly when their integer values are equal, or when
+    they are equal according to the column collation, which also provides
+    the hash function. Temporal, decimal, floating point, enum/set, bit,
+    blob, json and spatial columns are not hashed.
+
+  RETURN
+    TRUE    the column can be used as a hash join key
+    FALSE   otherwise
+*/
+
+static bool hash_join_key_type(const Field *field, Item_result *type)
+{
+  switch (field->real_type())
+  {
+  case MYSQL_TYPE_TINY:
+  case MYSQL_TYPE_SHORT:
+  case MYSQL_TYPE_INT24:
+  case MYSQL_TYPE_LONG:
+  case MYSQL_TYPE_LONGLONG:
+    *type= INT_RESULT;
+    return true;
+  case MYSQL_TYPE_VARCHAR:
+  case MYSQL_TYPE_STRING:
+  case MYSQL_TYPE_VAR_STRING:
+    *type= STRING_RESULT;
+    return true;
+  default:
+    return false;
+  }
+}
+
+
+/*
+  Check whether an equality of two columns can be evaluated by hashing
+
+  SYNOPSIS
+    is_hash_join_field_pair()
+      inner_field   column of the joined table
+      outer_field   column of a table joined earlier
+
+  RETURN
+    TRUE    both columns are hashed as integers, or both are hashed as
+            strings of the same collation
+    FALSE   otherwise
+*/
+
+bool is_hash_join_field_pair(const Field *inner_field,
+                             const Field *outer_field)
+{
+  Item_result inner_type, outer_type;
+  if (!hash_join_key_type(inner_field, &inner_type) ||
+      !hash_join_key_type(outer_field, &outer_type) ||
+      inner_type != outer_type)
+    return false;
+  return inner_type == INT_RESULT ||
+         inner_field->charset() == outer_field->charset();
+}
+
+
+/*
+  Check whether a condition is an equi-join condition usable for hashing
+
+  SYNOPSIS
+    get_hash_join_args()
+      cond        the condition
+      inner_map   map of the joined table
+      outer_map   map of the tables joined earlier
+      inner_arg   OUT: the argument of the equality depending on inner_map
+      outer_arg   OUT: the argument of the equality depending on outer_map
+      cs          OUT: collation to hash the values with, NULL if the
+                  values are hashed as integers
+
+  DESCRIPTION
+    The function accepts conditions of the form 'inner_col = outer_col'
+    where inner_col is a column of the joined table, outer_col is a column
+    of one of the tables joined earlier and the pair of columns is
+    accepted by is_hash_join_field_pair(). For string columns the
+    comparison must be done in the collation of the columns.
+
+  RETURN
+    TRUE    the condition can be evaluated by hashing, the OUT parameters
+            are set
+    FALSE   otherwise
+*/
+
+bool get_hash_join_args(Item *cond, table_map inner_map,
+                        table_map outer_map, Item **inner_arg,
+                        Item **outer_arg, const CHARSET_INFO **cs)
+{
+  if (cond->type() != Item::FUNC_ITEM ||
+      static_cast<Item_func*>(cond)->functype() != Item_func::EQ_FUNC)
+    return false;
+
+  Item_func_eq *const eq= static_cast<Item_func_eq*>(cond);
+  Item **const args= eq->arguments();
+  if (args[0]->real_item()->type() != Item::FIELD_ITEM ||
+      args[1]->real_item()->type() != Item::FIELD_ITEM)
+    return false;
+
+  for (uint i= 0; i < 2; i++)
+  {
+    Item *const inner= args[i];
+    Item *const outer= args[1 - i];
+    if (inner->used_tables() != inner_map ||
+        outer->used_tables() == 0 ||
+        (outer->used_tables() & ~outer_map))
+      continue;
+
+    const Field *const inner_field=
+      static_cast<Item_field*>(inner->real_item())->field;
+    const Field *const outer_field=
+      static_cast<Item_field*>(outer->real_item())->field;
+    if (!is_hash_join_field_pair(inner_field, outer_field))
+      return false;
+    if (inner_field->result_type() == STRING_RESULT)
+    {
+      if (eq->compare_collation() != inner_field->charset())
+        return false;
+      *cs= inner_field->charset();
+    }
+    else
+      *cs= NULL;
+    *inner_arg= inner;
+    *outer_arg= outer;
+    return true;
+  }
+  return false;
+}
+
+
 /* 
   Initialize a BKA cache       
 
@@ -2053,6 +2236,9 @@ enum_nested_loop_state JOIN_CACHE_BNL::join_matching_records(bool skip_last)
   // See setup_join_buffering(=: dynamic range => no cache.
   DBUG_ASSERT(!(qep_tab->dynamic_range() && qep_tab->quick()));
 
+  if (is_hashed())
+    return join_hashed_records(skip_last);
+
   /* Start retrieving all records of the joined table */
   if ((error= (*qep_tab->read_first_record)(qep_tab)))
     return error < 0 ? NESTED_LOOP_OK : NESTED_LOOP_ERROR;
@@ -2114,6 +2300,243 @@ enum_nested_loop_state JOIN_CACHE_BNL::join_matching_records(bool skip_last)
 }
 
 
+/*
+  Calculate the hash value of an argument of the hash join equality
+
+  SYNOPSIS
+    hash_value()
+      item    hash_inner_arg or hash_outer_arg
+      hash    OUT: the hash value
+
+  RETURN
+    TRUE    the value is NULL (it cannot match anything)
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNL::hash_value(Item *item, ulong *hash)
+{
+  if (hash_cs == NULL)
+  {
+    const ulonglong value= static_cast<ulonglong>(item->val_int());
+    if (item->null_value)
+      return true;
+    /* Fibonacci hashing: spread the bits of the value to the low bits */
+    *hash= static_cast<ulong>((value * 0x9E3779B97F4A7C15ULL) >> 32);
+    return false;
+  }
+
+  const String *const str= item->val_str(&hash_str);
+  if (item->null_value)
+    return true;
+  ulong nr1= 1, nr2= 4;
+  hash_cs->coll->hash_sort(hash_cs, (const uchar*) str->ptr(),
+                           str->length(), &nr1, &nr2);
+  *hash= nr1;
+  return false;
+}
+
+
+/*
+  Allocate the hash table for records from the join buffer
+
+  SYNOPSIS
+    alloc_hash_table()
+      count   number of records to be put into the hash table
+
+  DESCRIPTION
+    The hash table is reused for all refills of the join buffer and is
+    reallocated only when it is too small for 'count' records. The number
+    of buckets is the number of entries rounded up to a power of 2.
+
+  RETURN
+    FALSE   the hash table has been allocated
+    TRUE    out of memory
+*/
+
+bool JOIN_CACHE_BNL::alloc_hash_table(uint count)
+{
+  if (count <= hash_size)
+    return false;
+
+  uint size= 16;
+  while (size < count)
+    size<<= 1;
+
+  my_free(hash_entries);
+  my_free(hash_buckets);
+  hash_entries= (Hash_entry*) my_malloc(key_memory_JOIN_CACHE,
+                                        size * sizeof(Hash_entry),
+                                        MYF(MY_WME));
+  hash_buckets= (uint*) my_malloc(key_memory_JOIN_CACHE,
+                                  size * sizeof(uint), MYF(MY_WME));
+  if (hash_entries == NULL || hash_buckets == NULL)
+  {
+    my_free(hash_entries);
+    hash_entries= NULL;
+    my_free(hash_buckets);
+    hash_buckets= NULL;
+    hash_size= 0;
+    return true;
+  }
+  hash_size= size;
+  hash_mask= size - 1;
+  return false;
+}
+
+
+/*
+  Put the records from the join buffer into the hash table
+
+  SYNOPSIS
+    build_hash_table()
+      count   number of records from the join buffer to put into the table
+
+  DESCRIPTION
+    The function reads the first 'count' records from the join buffer and
+    links each of them into the chain of the hash value of hash_outer_arg.
+    Records where hash_outer_arg is NULL are not put into the table as they
+    cannot satisfy the equality. The chains list the records in the order
+    they are stored in the join buffer, so matches are generated in the
+    same order as with the plain BNL algorithm.
+    When the function returns 'pos' points right after the last read
+    record, as it does after a full scan of the join buffer.
+
+  RETURN
+    FALSE   the hash table has been built
+    TRUE    an error occurred
+*/
+
+bool JOIN_CACHE_BNL::build_hash_table(uint count)
+{
+  if (alloc_hash_table(count))
+    return true;
+  memset(hash_buckets, 0, (hash_mask + 1) * sizeof(uint));
+
+  uint entries= 0;
+  reset_cache(false);
+  for (uint cnt= count; cnt; cnt--)
+  {
+    get_record();
+    ulong hash;
+    if (hash_value(hash_outer_arg, &hash))
+      continue;
+    hash_entries[entries].rec_ptr= get_curr_rec();
+    hash_entries[entries].hash= hash;
+    entries++;
+  }
+  if (join->thd->is_error())
+    return true;
+
+  for (uint i= entries; i; i--)
+  {
+    Hash_entry *const entry= &hash_entries[i - 1];
+    uint *const bucket= &hash_buckets[entry->hash & hash_mask];
+    entry->next= *bucket;
+    *bucket= i;
+  }
+  return false;
+}
+
+
+/*
+  Using a hash table find matches from the next table for records from the
+  join buffer
+
+  SYNOPSIS
+    join_hashed_records()
+      skip_last    do not look for matches for the last partial join record
+
+  DESCRIPTION
+    This is the hash join variant of join_matching_records(), used when an
+    equi-join condition 'hash_inner_arg = hash_outer_arg' has been found
+    by init(). The records from the join buffer are put into a hash table
+    on the value of hash_outer_arg once per refill of the buffer. Then for
+    every row of the joined table only the records from the chain of the
+    hash value of hash_inner_arg are read back and checked, instead of all
+    records from the join buffer. check_match() evaluates the complete
+    condition, so hash collisions do not affect the result.
+
+  NOTES
+    The join buffer plays the role of a partition of the build input:
+    when join_buffer_size is exceeded the buffer is joined and refilled,
+    exactly as with the plain BNL algorithm, so the hash table never
+    holds more records than the join buffer.
+
+  RETURN
+    return one of enum_nested_loop_state.
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNL::join_hashed_records(bool skip_last)
+{
+  int error;
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+
+  /* Start retrieving all records of the joined table */
+  if ((error= (*qep_tab->read_first_record)(qep_tab)))
+    return error < 0 ? NESTED_LOOP_OK : NESTED_LOOP_ERROR;
+
+  if (build_hash_table(records - MY_TEST(skip_last)))
+    return NESTED_LOOP_ERROR;
+
+  READ_RECORD *info= &qep_tab->read_record;
+  do
+  {
+    if (qep_tab->keep_current_rowid)
+      qep_tab->table()->file->position(qep_tab->table()->record[0]);
+
+    if (join->thd->killed)
+    {
+      /* The user has aborted the execution of the query */
+      join->thd->send_kill_message();
+      return NESTED_LOOP_KILLED;
+    }
+
+    if (rc == NESTED_LOOP_OK)
+    {
+      join->examined_rows++;
+      if (const_cond)
+      {
+        const bool consider_record= const_cond->val_int() != FALSE;
+        if (join->thd->is_error())              // error in condition evaluation
+          return NESTED_LOOP_ERROR;
+        if (!consider_record)
+          continue;
+      }
+
+      ulong hash;
+      const bool is_null= hash_value(hash_inner_arg, &hash);
+      if (join->thd->is_error())
+        return NESTED_LOOP_ERROR;
+      if (is_null)
+        continue;
+
+      /* Read the records with the same hash value and look for matches */
+      for (uint i= hash_buckets[hash & hash_mask]; i;
+           i= hash_entries[i - 1].next)
+      {
+        uchar *const rec_ptr= hash_entries[i - 1].rec_ptr;
+        if (hash_entries[i - 1].hash != hash)
+          continue;
+        /*
+          If only the first match is needed and it has been already found for
+          the record from the join buffer then the record is skipped.
+        */
+        if (check_only_first_match && get_match_flag_by_pos(rec_ptr))
+          continue;
+        get_record_by_pos(rec_ptr);
+        rc= generate_full_extensions(rec_ptr);
+        if (rc != NESTED_LOOP_OK)
+          return rc;
+      }
+    }
+  } while (!(error= info->read_record(info)));
+
+  if (error > 0)				// Fatal error
+    rc= NESTED_LOOP_ERROR;
+  return rc;
+}
+
+
 bool JOIN_CACHE::calc_check_only_first_match(const QEP_TAB *t) const
 {
   if ((t->last_sj_inner() == t->idx() &&
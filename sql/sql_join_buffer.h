@@ -509,20 +509,80 @@ protected:
   /* Using BNL find matches from the next table for records from join buffer */
   enum_nested_loop_state join_matching_records(bool skip_last);
 
+  /* Using a hash table find matches for records from join buffer */
+  enum_nested_loop_state join_hashed_records(bool skip_last);
+
 public:
   JOIN_CACHE_BNL(JOIN *j, QEP_TAB *qep_tab_arg, JOIN_CACHE *prev)
-    : JOIN_CACHE(j, qep_tab_arg, prev), const_cond(NULL)
+    : JOIN_CACHE(j, qep_tab_arg, prev), const_cond(NULL),
+    hash_inner_arg(NULL), hash_outer_arg(NULL), hash_cs(NULL),
+    hash_entries(NULL), hash_buckets(NULL), hash_size(0), hash_mask(0)
   {}
 
   /* Initialize the BNL cache */       
   int init();
 
+  void mem_free()
+  {
+    my_free(hash_entries);
+    hash_entries= NULL;
+    my_free(hash_buckets);
+    hash_buckets= NULL;
+    hash_size= 0;
+    hash_str.mem_free();
+    JOIN_CACHE::mem_free();
+  }
+
   enum_join_cache_type cache_type() const { return ALG_BNL; }
 
+  /**
+    TRUE <=> records from the join buffer are looked up through a hash
+    table built on an equi-join condition instead of being compared
+    one by one with every row of the joined table.
+  */
+  bool is_hashed() const { return hash_inner_arg != NULL; }
+
 private:
   Item *const_cond;
+
+  /*
+    Arguments of the equality 'inner_arg = outer_arg' used to hash the
+    records: inner_arg depends only on the joined table, outer_arg only on
+    the tables whose records are stored in the join buffer (or in the
+    buffers of the previous caches). hash_cs is the collation used to hash
+    string values, NULL if the values are compared as integers.
+  */
+  Item *hash_inner_arg;
+  Item *hash_outer_arg;
+  const CHARSET_INFO *hash_cs;
+
+  /* An entry of the hash table: one record from the join buffer */
+  struct Hash_entry
+  {
+    uchar *rec_ptr;  /**< position of the record in the join buffer */
+    ulong hash;      /**< hash value of hash_outer_arg for the record */
+    uint next;       /**< 1 + index of the next entry in the chain, or 0 */
+  };
+  Hash_entry *hash_entries;
+  /* 1 + index of the first entry of each chain, or 0 for an empty chain */
+  uint *hash_buckets;
+  /* Number of allocated entries, same as the number of buckets */
+  uint hash_size;
+  uint hash_mask;
+  /* Buffer for string values of the hashed arguments */
+  StringBuffer<MAX_FIELD_WIDTH> hash_str;
+
+  bool hash_value(Item *item, ulong *hash);
+  bool alloc_hash_table(uint count);
+  bool build_hash_table(uint count);
 };
 
+bool get_hash_join_args(Item *cond, table_map inner_map,
+                        table_map outer_map, Item **inner_arg,
+                        Item **outer_arg, const CHARSET_INFO **cs);
+bool is_hash_join_field_pair(const Field *inner_field,
+                             const Field *outer_field);
+
 class JOIN_CACHE_BKA :public JOIN_CACHE
 {
 protected:
@@ -2284,6 +2284,7 @@ st_select_lex::st_select_lex
   select_list_tables(0),
   outer_join(0),
   opt_hints_qb(NULL),
+  cached_join_order(NULL),
   m_agg_func_used(false),
   sj_candidates(NULL)
 {
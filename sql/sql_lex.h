@@ -76,6 +76,7 @@ typedef class st_select_lex SELECT_LEX;
 const size_t INITIAL_LEX_PLUGIN_LIST_SIZE = 16;
 class Opt_hints_global;
 class Opt_hints_qb;
+struct Cached_join_order;
 
 #ifdef MYSQL_SERVER
 /*
@@ -1098,6 +1099,12 @@ public:
   /// Query-block-level hints, for this query block
   Opt_hints_qb *opt_hints_qb;
 
+  /**
+    Join order kept by the previous execution of a prepared statement or
+    stored program statement, @see Optimize_table_order::choose_table_order()
+  */
+  Cached_join_order *cached_join_order;
+
 
   /**
     @note the group_by and order_by lists below will probably be added to the
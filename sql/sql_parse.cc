@@ -1954,7 +1954,7 @@ done:
   thd->m_digest= NULL;
 
   thd_manager->dec_thread_running();
-  free_root(thd->mem_root,MYF(MY_KEEP_PREALLOC));
+  trim_root(thd->mem_root, thd->variables.query_alloc_keep_size);
 
   /* DTRACE instrumentation, end */
   if (MYSQL_QUERY_DONE_ENABLED() && command == COM_QUERY)
@@ -5784,10 +5784,20 @@ void mysql_parse(THD *thd, Parser_state *parser_state)
   {
     LEX *lex= thd->lex;
     const char *found_semicolon;
+    Prepared_statement *cached_stmt= NULL;
 
     bool err= thd->get_stmt_da()->is_error();
 
-    if (!err)
+    if (!err && (cached_stmt= thd->parse_cache.find(thd)))
+    {
+      /*
+        The query is not parsed into thd->lex: publish its command for the
+        general log, the audit plugins and the user statistics.
+      */
+      lex->sql_command= cached_stmt->lex->sql_command;
+      found_semicolon= NULL;
+    }
+    else if (!err)
     {
       err= parse_sql(thd, parser_state, NULL);
       if (!err)
@@ -5893,6 +5903,8 @@ void mysql_parse(THD *thd, Parser_state *parser_state)
             my_error(ER_MUST_CHANGE_PASSWORD, MYF(0));
             error= 1;
           }
+          else if (cached_stmt)
+            error= thd->parse_cache.execute(thd, cached_stmt);
           else
             error= mysql_execute_command(thd, true);
 
@@ -34,6 +34,7 @@
 #include <my_bit.h>
 #include "opt_hints.h"   // hint_table_state()
 #include "parse_tree_hints.h"
+#include "sql_join_buffer.h" // get_hash_join_args()
 
 #include <algorithm>
 using std::max;
@@ -705,6 +706,72 @@ Key_use* Optimize_table_order::find_best_ref(JOIN_TAB *tab,
   return best_ref;
 }
 
+/**
+  Check whether a condition contains an equi-join condition that lets the
+  join buffer of 'tab' be used as a hash table.
+
+  Only top-level conjuncts are examined. Besides plain equalities, a
+  multiple equality without a constant is accepted if it contains a
+  column of 'tab' and a column of a table in the prefix that can be hashed
+  together: it will be turned into such an equality for 'tab' after the
+  join order has been chosen.
+
+  @param cond        condition to examine, may be NULL
+  @param tab         table to be joined with a join buffer
+  @param outer_map   tables in the partial plan before 'tab'
+
+  @return true if JOIN_CACHE_BNL will be able to hash the join buffer
+*/
+
+static bool has_hash_join_cond(Item *cond, const JOIN_TAB *tab,
+                               table_map outer_map)
+{
+  if (cond == NULL)
+    return false;
+
+  if (cond->type() == Item::COND_ITEM &&
+      static_cast<Item_cond*>(cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    List_iterator<Item> li(*static_cast<Item_cond*>(cond)->argument_list());
+    Item *item;
+    while ((item= li++))
+    {
+      if (has_hash_join_cond(item, tab, outer_map))
+        return true;
+    }
+    return false;
+  }
+
+  const table_map inner_map= tab->table_ref->map();
+  if (cond->type() == Item::FUNC_ITEM &&
+      static_cast<Item_func*>(cond)->functype() ==
+      Item_func::MULT_EQUAL_FUNC)
+  {
+    Item_equal *const item_equal= static_cast<Item_equal*>(cond);
+    if (item_equal->get_const())
+      return false;
+    const Field *inner_field= NULL;
+    const Field *outer_field= NULL;
+    Item_equal_iterator it(*item_equal);
+    Item_field *item;
+    while ((item= it++))
+    {
+      const table_map map= item->used_tables();
+      if (map == inner_map)
+        inner_field= item->field;
+      else if (map != 0 && !(map & ~outer_map))
+        outer_field= item->field;
+    }
+    return inner_field != NULL && outer_field != NULL &&
+           is_hash_join_field_pair(inner_field, outer_field);
+  }
+
+  Item *inner_arg, *outer_arg;
+  const CHARSET_INFO *cs;
+  return get_hash_join_args(cond, inner_map, outer_map,
+                            &inner_arg, &outer_arg, &cs);
+}
+
 /**
   Calculate the cost of range/table/index scanning table 'tab'.
 
@@ -1082,8 +1149,28 @@ void Optimize_table_order::best_access_path(JOIN_TAB *tab,
       This cost plus scan_cost gives us total cost of using
       TABLE/INDEX/RANGE SCAN.
     */
+    double rows_evaluated= prefix_rowcount * rows_after_filtering;
+
+    /*
+      With hash join the rows are hashed once on each side, and the WHERE
+      clause is evaluated only for the combinations of rows that agree on
+      the equi-join condition.
+      The conditions of inner tables of outer joins are attached wrapped in
+      trigger conditions, which JOIN_CACHE_BNL does not hash.
+    */
+    if (!disable_jbuf &&
+        thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_JOIN) &&
+        !tab->table_ref->is_inner_table_of_outer_join() &&
+        has_hash_join_cond(join->where_cond, tab,
+                           ~remaining_tables & ~tab->table_ref->map()))
+    {
+      rows_evaluated= prefix_rowcount + rows_after_filtering +
+                      rows_evaluated * COND_FILTER_EQUALITY;
+      trace_access_scan.add("using_hash_join", true);
+    }
+
     const double scan_total_cost= scan_read_cost +
-      cost_model->row_evaluate_cost(prefix_rowcount * rows_after_filtering);
+      cost_model->row_evaluate_cost(rows_evaluated);
 
     trace_access_scan.add("resulting_rows", rows_after_filtering);
     trace_access_scan.add("cost", scan_total_cost);
@@ -1846,6 +1933,16 @@ bool Optimize_table_order::choose_table_order()
     join->select_lex->active_options() & SELECT_STRAIGHT_JOIN;
   table_map join_tables;      ///< The tables involved in order selection
 
+  /*
+    The join order of a statement which is executed several times is kept
+    in its query block, for a complete plan without semi-join nests.
+  */
+  const bool plan_cache=
+    thd->optimizer_switch_flag(OPTIMIZER_SWITCH_PLAN_CACHE) &&
+    !thd->stmt_arena->is_conventional() &&
+    !emb_sjm_nest && !has_sj && !straight_join && join->allow_outer_refs;
+  bool cached_order= false;
+
   if (emb_sjm_nest)
   {
     /* We're optimizing semi-join materialization nest, so put the 
@@ -1870,7 +1967,7 @@ bool Optimize_table_order::choose_table_order()
       merge_sort(join->best_ref + join->const_tables,
                  join->best_ref + join->tables,
                  Join_tab_compare_straight());
-    else 
+    else if (!(plan_cache && (cached_order= use_cached_join_order())))
       merge_sort(join->best_ref + join->const_tables,
                  join->best_ref + join->tables,
                  Join_tab_compare_default());
@@ -1879,6 +1976,8 @@ bool Optimize_table_order::choose_table_order()
   }
 
   Opt_trace_object wrapper(&join->thd->opt_trace);
+  if (cached_order)
+    wrapper.add("cached_join_order", true);
   Opt_trace_array
     trace_plan(&join->thd->opt_trace, "considered_execution_plans",
                Opt_trace_context::GREEDY_SEARCH);
@@ -1898,7 +1997,7 @@ bool Optimize_table_order::choose_table_order()
                            Item::WALK_POSTFIX, NULL);
   }
 
-  if (straight_join)
+  if (straight_join || cached_order)
     optimize_straight_join(join_tables);
   else
   {
@@ -1906,6 +2005,14 @@ bool Optimize_table_order::choose_table_order()
       DBUG_RETURN(true);
   }
 
+  if (cached_order)
+    thd->status_var.plan_cache_hits++;
+  else if (plan_cache)
+  {
+    thd->status_var.plan_cache_misses++;
+    cache_join_order();
+  }
+
   // Remaining part of this function not needed when processing semi-join nests.
   if (emb_sjm_nest)
     DBUG_RETURN(false);
@@ -1918,6 +2025,105 @@ bool Optimize_table_order::choose_table_order()
 }
 
 
+/**
+  Class of an estimated row count: the number of significant bits, so that
+  row counts within a factor of two of each other are mostly in the same
+  class.
+*/
+
+static uint join_order_rows_class(ha_rows rows)
+{
+  uint rows_class= 0;
+  for (; rows != 0; rows>>= 1)
+    rows_class++;
+  return rows_class;
+}
+
+
+/**
+  Arrange join->best_ref in the join order kept by a previous execution of
+  the statement, if that order is still valid.
+
+  The order is reused when the same tables are const and the row estimate
+  of every other table, as computed by JOIN::estimate_rowcount() with the
+  current statistics and parameter values, is in the same class as when
+  the order was chosen. Otherwise a new join order search is needed.
+
+  @return true if join->best_ref is in the cached order, false if
+          join->best_ref is unchanged
+*/
+
+bool Optimize_table_order::use_cached_join_order()
+{
+  const Cached_join_order *const cache= join->select_lex->cached_join_order;
+  if (cache == NULL ||
+      cache->table_count != join->tables ||
+      cache->const_tables != join->const_table_map)
+    return false;
+
+  JOIN_TAB **const best_ref= join->best_ref;
+
+  // Check every position before changing best_ref
+  for (uint idx= join->const_tables; idx < join->tables; idx++)
+  {
+    const JOIN_TAB *tab= NULL;
+    for (uint i= join->const_tables; i < join->tables && tab == NULL; i++)
+    {
+      if (best_ref[i]->table_ref->tableno() == cache->order[idx])
+        tab= best_ref[i];
+    }
+    if (tab == NULL ||
+        join_order_rows_class(tab->found_records) != cache->rows_class[idx])
+      return false;
+  }
+
+  for (uint idx= join->const_tables; idx < join->tables; idx++)
+  {
+    uint i= idx;
+    while (best_ref[i]->table_ref->tableno() != cache->order[idx])
+      i++;
+    std::swap(best_ref[idx], best_ref[i]);
+  }
+  return true;
+}
+
+
+/**
+  Keep the join order found by the search in the query block, for the
+  next executions of the statement, @see use_cached_join_order().
+
+  The cache is allocated in the memory of the prepared statement or stored
+  program statement. Failing to allocate it is not an error: the next
+  execution will search for a join order again.
+*/
+
+void Optimize_table_order::cache_join_order()
+{
+  MEM_ROOT *const mem_root= thd->stmt_arena->mem_root;
+  Cached_join_order *cache= join->select_lex->cached_join_order;
+
+  if (cache == NULL || cache->table_count != join->tables)
+  {
+    if (!(cache= new (mem_root) Cached_join_order) ||
+        !(cache->order=
+            (uint *) alloc_root(mem_root, join->tables * sizeof(uint))) ||
+        !(cache->rows_class=
+            (uint *) alloc_root(mem_root, join->tables * sizeof(uint))))
+      return;                                 /* purecov: inspected */
+    cache->table_count= join->tables;
+    join->select_lex->cached_join_order= cache;
+  }
+
+  cache->const_tables= join->const_table_map;
+  for (uint idx= join->const_tables; idx < join->tables; idx++)
+  {
+    const JOIN_TAB *const tab= join->best_positions[idx].table;
+    cache->order[idx]= tab->table_ref->tableno();
+    cache->rows_class[idx]= join_order_rows_class(tab->found_records);
+  }
+}
+
+
 /**
   Heuristic procedure to automatically guess a reasonable degree of
   exhaustiveness for the greedy search procedure.
@@ -41,6 +41,26 @@ class Opt_trace_object;
   best_extension_by_limited_search() and eq_ref_extension_by_limited_search().
 */
 
+/**
+  Join order chosen for a query block of a prepared statement or stored
+  program statement, kept across executions so that the join order search
+  can be skipped when the statement is executed again with similar row
+  estimates, @see Optimize_table_order::choose_table_order().
+*/
+
+struct Cached_join_order
+{
+  /// Const tables of the join when the order was chosen
+  table_map const_tables;
+  /// Number of tables of the join, including the const ones
+  uint table_count;
+  /// tableno() of the table at each position of the join order
+  uint *order;
+  /// Class of the estimated row count of the table at each position
+  uint *rows_class;
+};
+
+
 class Optimize_table_order
 {
 public:
@@ -134,6 +154,8 @@ private:
                                                       uint      idx,
                                                       POSITION *loose_scan_pos);
   bool check_interleaving_with_nj(JOIN_TAB *next_tab);
+  bool use_cached_join_order();
+  void cache_join_order();
   void advance_sj_state(table_map remaining_tables,
                         const JOIN_TAB *tab, uint idx);
   void backout_nj_state(const table_map remaining_tables,
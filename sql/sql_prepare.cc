@@ -864,7 +864,7 @@ PSI_prepared_stmt* Prepared_statement::get_PS_prepared_stmt()
 */
 
 bool Prepared_statement::insert_params(uchar *null_array,
-                                       uchar *read_pos, uchar *data_end,
+                                       uchar **read_pos, uchar *data_end,
                                        String *query)
 {
   Item_param **begin= param_array;
@@ -887,9 +887,9 @@ bool Prepared_statement::insert_params(uchar *null_array,
         param->set_null();
       else
       {
-        if (read_pos >= data_end)
+        if (*read_pos >= data_end)
           DBUG_RETURN(1);
-        param->set_param_func(param, &read_pos, (uint) (data_end - read_pos));
+        param->set_param_func(param, read_pos, (uint) (data_end - *read_pos));
         if (param->state == Item_param::NO_VALUE)
           DBUG_RETURN(1);
 
@@ -2659,7 +2659,19 @@ void mysqld_stmt_execute(THD *thd, ulong stmt_id, ulong flags, uchar *params,
   thd->set_protocol(&thd->protocol_binary);
 
   MYSQL_EXECUTE_PS(thd->m_statement_psi, stmt->m_prepared_stmt);
-  
+
+#ifndef EMBEDDED_LIBRARY
+  /* Other clients may send the flag with another meaning */
+  if ((flags & (ulong) PARAMETER_BATCH) &&
+      thd->get_protocol()->has_client_capability(CLIENT_STMT_PARAMETER_BATCH))
+  {
+    if (open_cursor)
+      my_error(ER_WRONG_ARGUMENTS, MYF(0), "mysqld_stmt_execute");
+    else
+      stmt->execute_batch(&expanded_query, params, params + params_length);
+  }
+  else
+#endif
   stmt->execute_loop(&expanded_query, open_cursor, params,
                     params + params_length);
   thd->set_protocol(save_protocol);
@@ -3522,8 +3534,11 @@ bool Prepared_statement::prepare(const char *query_str, size_t query_length)
     If this is an SQLCOM_PREPARE, we also increase Com_prepare_sql.
     However, it seems handy if com_stmt_prepare is increased always,
     no matter what kind of prepare is processed.
+    Statements of the parse cache are not prepared by the client and are
+    not counted.
   */
-  thd->status_var.com_stmt_prepare++;
+  if (!is_parse_cache())
+    thd->status_var.com_stmt_prepare++;
 
   if (! (lex= new (mem_root) st_lex_local))
     DBUG_RETURN(TRUE);
@@ -3581,6 +3596,9 @@ bool Prepared_statement::prepare(const char *query_str, size_t query_length)
   if (is_audit_plugin_class_active(thd, MYSQL_AUDIT_GENERAL_CLASS))
     parser_state.m_input.m_compute_digest= true;
 #endif
+  /* The digest is reported for the queries executed with the statement */
+  if (is_parse_cache())
+    parser_state.m_input.m_compute_digest= true;
 
   thd->m_parser_state = &parser_state;
   invoke_pre_parse_rewrite_plugins(thd);
@@ -3603,6 +3621,9 @@ bool Prepared_statement::prepare(const char *query_str, size_t query_length)
 
   lex->set_trg_event_type_for_tables();
 
+  if (!error && is_parse_cache())
+    m_digest= digest.m_digest_storage;
+
   /*
     Pre-clear the diagnostics area unless a warning was thrown
     during parsing.
@@ -3713,8 +3734,11 @@ bool Prepared_statement::prepare(const char *query_str, size_t query_length)
       we're inside a stored procedure (also called Dynamic SQL) --
       sub-statements inside stored procedures are not logged into
       the general log.
+
+      Statements of the parse cache are not logged either: the queries
+      executed with them are logged as they were received.
     */
-    if (thd->sp_runtime_ctx == NULL)
+    if (thd->sp_runtime_ctx == NULL && !is_parse_cache())
     {
       if (thd->rewritten_query.length())
         query_logger.general_log_write(thd, COM_STMT_PREPARE,
@@ -3745,7 +3769,8 @@ bool Prepared_statement::prepare(const char *query_str, size_t query_length)
                          '?' placeholders will be replaced with
                          their values in case of success.
                          The result is used for logging and replication
-  @param packet          pointer to execute packet.
+  @param packet          pointer to execute packet, moved past the
+                         parameters that are read.
                          NULL in case of SQL PS
   @param packet_end      end of the packet. NULL in case of SQL PS
 
@@ -3759,9 +3784,9 @@ bool Prepared_statement::prepare(const char *query_str, size_t query_length)
 
 bool
 Prepared_statement::set_parameters(String *expanded_query,
-                                   uchar *packet, uchar *packet_end)
+                                   uchar **packet, uchar *packet_end)
 {
-  bool is_sql_ps= packet == NULL;
+  bool is_sql_ps= *packet == NULL;
   bool res= FALSE;
 
   if (is_sql_ps)
@@ -3773,8 +3798,8 @@ Prepared_statement::set_parameters(String *expanded_query,
   else if (param_count)
   {
 #ifndef EMBEDDED_LIBRARY
-    uchar *null_array= packet;
-    res= (setup_conversion_functions(this, &packet, packet_end) ||
+    uchar *null_array= *packet;
+    res= (setup_conversion_functions(this, packet, packet_end) ||
           insert_params(null_array, packet, packet_end, expanded_query));
 #else
     /*
@@ -3822,13 +3847,9 @@ bool
 Prepared_statement::execute_loop(String *expanded_query,
                                  bool open_cursor,
                                  uchar *packet,
-                                 uchar *packet_end)
+                                 uchar *packet_end,
+                                 uchar **packet_next)
 {
-  const int MAX_REPREPARE_ATTEMPTS= 3;
-  Reprepare_observer reprepare_observer;
-  bool error;
-  int reprepare_attempt= 0;
-
   /* Check if we got an error when sending long data */
   if (state == Query_arena::STMT_ERROR)
   {
@@ -3838,8 +3859,31 @@ Prepared_statement::execute_loop(String *expanded_query,
 
   DBUG_ASSERT(!thd->get_stmt_da()->is_set());
 
-  if (set_parameters(expanded_query, packet, packet_end))
+  if (set_parameters(expanded_query, &packet, packet_end))
     return TRUE;
+  if (packet_next)
+    *packet_next= packet;
+
+  return execute_bound(expanded_query, open_cursor);
+}
+
+
+/**
+  Execute a prepared statement whose parameters have been assigned,
+  re-preparing it a limited number of times if necessary.
+
+  @see execute_loop()
+
+  @return TRUE if an error, FALSE if success
+*/
+
+bool
+Prepared_statement::execute_bound(String *expanded_query, bool open_cursor)
+{
+  const int MAX_REPREPARE_ATTEMPTS= 3;
+  Reprepare_observer reprepare_observer;
+  bool error;
+  int reprepare_attempt= 0;
 
   if (unlikely(thd->security_context()->password_expired() &&
                !lex->is_set_password_sql))
@@ -3895,6 +3939,78 @@ reexecute:
 }
 
 
+#ifndef EMBEDDED_LIBRARY
+/**
+  Execute a prepared statement once for each of the parameter sets sent
+  together in one COM_STMT_EXECUTE packet with the PARAMETER_BATCH flag.
+
+  The parameter sets follow each other in the format of a single
+  COM_STMT_EXECUTE. The parameter types need only be sent with the first
+  set. The statement is executed for the sets back to back, cleaning up
+  between them as between two commands, and one OK packet is sent for the
+  whole batch with the total of the affected rows, the first generated
+  auto-increment value and the number of sets in its message. Execution
+  stops at the first error, which is sent instead, with a note telling how
+  many sets were applied before it; their executions are not undone.
+
+  Only statements which change data and don't return a result set can be
+  executed in a batch.
+
+  @return TRUE if an error, FALSE if success
+*/
+
+bool
+Prepared_statement::execute_batch(String *expanded_query,
+                                  uchar *packet, uchar *packet_end)
+{
+  ulonglong affected_rows= 0;
+  ulonglong first_insert_id= 0;
+  ulong applied_sets= 0;
+  char buff[MYSQL_ERRMSG_SIZE];
+
+  if (!param_count ||
+      !(sql_command_flags[lex->sql_command] & CF_CHANGES_DATA) ||
+      lex->sql_command == SQLCOM_CALL)
+  {
+    my_error(ER_NOT_SUPPORTED_YET, MYF(0),
+             "batched execution of this statement");
+    return TRUE;
+  }
+
+  for (;;)
+  {
+    if (execute_loop(expanded_query, FALSE, packet, packet_end, &packet))
+    {
+      /* Tell how many sets were applied before the one that failed */
+      push_warning_printf(thd, Sql_condition::SL_NOTE, ER_STMT_BATCH_SETS,
+                          ER(ER_STMT_BATCH_SETS), applied_sets);
+      return TRUE;
+    }
+
+    applied_sets++;
+    if (thd->get_stmt_da()->is_ok())
+    {
+      affected_rows+= thd->get_stmt_da()->affected_rows();
+      if (!first_insert_id)
+        first_insert_id= thd->get_stmt_da()->last_insert_id();
+    }
+    if (packet >= packet_end)
+      break;
+
+    /* Clean up as after a command before executing the next set */
+    thd->reset_query();
+    free_root(thd->mem_root, MYF(MY_KEEP_PREALLOC));
+    mysql_reset_thd_for_next_command(thd);
+  }
+
+  thd->get_stmt_da()->reset_diagnostics_area();
+  my_snprintf(buff, sizeof(buff), ER(ER_STMT_BATCH_SETS), applied_sets);
+  my_ok(thd, affected_rows, first_insert_id, buff);
+  return FALSE;
+}
+#endif
+
+
 bool
 Prepared_statement::execute_server_runnable(Server_runnable *server_runnable)
 {
@@ -3955,6 +4071,8 @@ Prepared_statement::reprepare()
   Prepared_statement copy(thd);
 
   copy.set_sql_prepare(); /* To suppress sending metadata to the client. */
+  if (is_parse_cache())
+    copy.set_parse_cache();
 
   thd->status_var.com_stmt_reprepare++;
 
@@ -4069,6 +4187,8 @@ Prepared_statement::swap_prepared_statement(Prepared_statement *copy)
   swap_variables(LEX_CSTRING, m_name, copy->m_name);
   /* Ditto */
   swap_variables(LEX_CSTRING, m_db, copy->m_db);
+  /* The token array of the digest is in the memory root */
+  swap_variables(sql_digest_storage, m_digest, copy->m_digest);
 
   DBUG_ASSERT(param_count == copy->param_count);
   DBUG_ASSERT(thd == copy->thd);
@@ -4107,7 +4227,8 @@ bool Prepared_statement::execute(String *expanded_query, bool open_cursor)
     { saved_cur_db_name_buf, sizeof(saved_cur_db_name_buf) };
   bool cur_db_changed;
 
-  thd->status_var.com_stmt_execute++;
+  if (!is_parse_cache())
+    thd->status_var.com_stmt_execute++;
 
   /*
     Reset the diagnostics area.
@@ -4262,7 +4383,8 @@ bool Prepared_statement::execute(String *expanded_query, bool open_cursor)
           a hash of that hash.
         */
         rewrite_query_if_needed(thd);
-        log_execute_line(thd);
+        if (!is_parse_cache())
+          log_execute_line(thd);
         thd->binlog_need_explicit_defaults_ts= lex->binlog_need_explicit_defaults_ts;
         error= mysql_execute_command(thd, true);
         MYSQL_QUERY_EXEC_DONE(error);
@@ -4325,6 +4447,804 @@ void Prepared_statement::deallocate()
 }
 
 
+/***************************************************************************
+* Parse_cache
+***************************************************************************/
+
+/** A literal of a query, replaced by a parameter marker. */
+
+struct Parse_cache_literal
+{
+  /** MYSQL_TYPE_LONGLONG, MYSQL_TYPE_NEWDECIMAL or MYSQL_TYPE_VARCHAR */
+  enum_field_types type;
+  /** Text of a number, or the value of a string without escapes */
+  const char *str;
+  size_t length;
+};
+
+typedef Mem_root_array<Parse_cache_literal, true> Parse_cache_literals;
+
+
+/**
+  A statement of the parse cache. The key is followed by the text the
+  statement is prepared from.
+*/
+
+struct Parse_cache_entry
+{
+  /** NULL if the text can't be prepared as a statement of the cache */
+  Prepared_statement *stmt;
+  /** Neighbours in the LRU list of the entry */
+  Parse_cache_entry *lru_prev, *lru_next;
+  size_t key_length;
+  char *key;
+};
+
+
+C_MODE_START
+
+static uchar *get_parse_cache_key(const uchar *record, size_t *length,
+                                  my_bool not_used MY_ATTRIBUTE((unused)))
+{
+  const Parse_cache_entry *entry=
+    reinterpret_cast<const Parse_cache_entry *>(record);
+  *length= entry->key_length;
+  return reinterpret_cast<uchar *>(entry->key);
+}
+
+
+static void free_parse_cache_entry(void *record)
+{
+  Parse_cache_entry *entry= static_cast<Parse_cache_entry *>(record);
+  delete entry->stmt;
+  my_free(entry);
+}
+
+C_MODE_END
+
+
+/** Maximum nesting of parentheses in a query of the parse cache. */
+static const uint PARSE_CACHE_MAX_DEPTH= 32;
+
+
+static inline bool is_word_char(const CHARSET_INFO *cs, uchar c)
+{
+  return my_isalnum(cs, c) || c == '_' || c == '$' || c >= 0x80;
+}
+
+
+static inline bool is_keyword(const char *word, size_t length,
+                              const char *keyword)
+{
+  return length == strlen(keyword) &&
+         !native_strncasecmp(word, keyword, length);
+}
+
+
+/**
+  Copy the text of a string literal without the quotes, resolving the
+  escapes as the lexer does in get_text().
+*/
+
+static size_t unescape_string(THD *thd, const char *str, const char *end,
+                              char quote, char *to)
+{
+  const CHARSET_INFO *cs= thd->charset();
+  const bool backslash_escapes=
+    !(thd->variables.sql_mode & MODE_NO_BACKSLASH_ESCAPES);
+  char *start= to;
+
+  while (str < end)
+  {
+    uint l;
+    if (use_mb(cs) && (l= my_ismbchar(cs, str, end)))
+    {
+      while (l--)
+        *to++= *str++;
+      continue;
+    }
+    if (backslash_escapes && *str == '\\' && str + 1 != end)
+    {
+      switch (*++str) {
+      case 'n':
+        *to++= '\n';
+        break;
+      case 't':
+        *to++= '\t';
+        break;
+      case 'r':
+        *to++= '\r';
+        break;
+      case 'b':
+        *to++= '\b';
+        break;
+      case '0':
+        *to++= 0;
+        break;
+      case 'Z':
+        *to++= '\032';
+        break;
+      case '_':
+      case '%':
+        *to++= '\\';
+        /* Fall through */
+      default:
+        *to++= *str;
+        break;
+      }
+      str++;
+    }
+    else if (*str == quote)
+    {
+      /* Two quotes */
+      *to++= *str;
+      str+= 2;
+    }
+    else
+      *to++= *str++;
+  }
+  return to - start;
+}
+
+
+/**
+  Replace the literals of a query with parameter markers.
+
+  Only the literals are replaced that have the same meaning as parameters:
+  not the ones in a select list, where the text of an expression names
+  the column of the result, not the ones in ORDER BY and GROUP BY, where
+  a number is a column position, and not the numbers with a sign or an
+  exponent or the strings with a character set introducer. If the parser
+  does not accept a parameter where a literal was replaced, the text is
+  not cached.
+
+  The query is rejected if it is not a single SELECT, INSERT, UPDATE,
+  DELETE or REPLACE statement, or if it has comments, which may hold
+  optimizer hints or version specific text, references to system
+  variables, which may depend on the diagnostics area of the previous
+  statement, or parameter markers.
+
+  @param thd             thread handle
+  @param query           text of the query
+  @param[out] text       buffer of query.length bytes for the text with
+                         the parameter markers
+  @param[out] text_length  length of the text
+  @param[out] literals   the literals, in the order of their markers
+
+  @retval false  success
+  @retval true   the query can't be executed with a statement of the cache
+*/
+
+static bool parameterize_query(THD *thd, const LEX_CSTRING &query,
+                               char *text, size_t *text_length,
+                               Parse_cache_literals *literals)
+{
+  const CHARSET_INFO *cs= thd->charset();
+  const bool backslash_escapes=
+    !(thd->variables.sql_mode & MODE_NO_BACKSLASH_ESCAPES);
+  const bool ansi_quotes= thd->variables.sql_mode & MODE_ANSI_QUOTES;
+  const char *pos= query.str;
+  const char *end= query.str + query.length;
+  char *to= text;
+  /* Clauses of the query block at each nesting level of parentheses */
+  struct
+  {
+    /** The SELECT keyword was seen at this level */
+    bool query_block;
+    bool select_list;
+    bool order_list;
+  } level[PARSE_CACHE_MAX_DEPTH];
+  uint depth= 0;
+  bool after_order= false;
+  bool started= false;
+  char last= 0;
+
+  level[0].query_block= level[0].select_list= level[0].order_list= false;
+
+  while (pos < end)
+  {
+    const char *start= pos;
+    const uchar c= *pos;
+    bool is_order= false;
+
+    if (my_isspace(cs, c))
+    {
+      *to++= *pos++;
+      continue;
+    }
+
+    if (!started && !is_word_char(cs, c))
+      return true;
+
+    if (is_word_char(cs, c))
+    {
+      /* Keyword, identifier or number */
+      bool is_number= true;
+      uint l;
+
+      while (pos < end && is_word_char(cs, *pos))
+      {
+        if (use_mb(cs) && (l= my_ismbchar(cs, pos, end)))
+        {
+          pos+= l;
+          is_number= false;
+          continue;
+        }
+        if (!my_isdigit(cs, *pos))
+          is_number= false;
+        pos++;
+      }
+      const size_t length= pos - start;
+      const bool qualified= start > query.str && start[-1] == '.';
+
+      if (!started)
+      {
+        if (!is_keyword(start, length, "SELECT") &&
+            !is_keyword(start, length, "INSERT") &&
+            !is_keyword(start, length, "UPDATE") &&
+            !is_keyword(start, length, "DELETE") &&
+            !is_keyword(start, length, "REPLACE"))
+          return true;
+        started= true;
+      }
+
+      if (!is_number)
+      {
+        if (qualified)
+          ;
+        else if (is_keyword(start, length, "SELECT"))
+        {
+          level[depth].query_block= true;
+          level[depth].select_list= true;
+          level[depth].order_list= false;
+        }
+        else if (is_keyword(start, length, "FROM") &&
+                 level[depth].query_block)
+        {
+          /* Not the FROM of e.g. SUBSTRING(b FROM 2) */
+          level[depth].select_list= false;
+        }
+        else if (is_keyword(start, length, "ORDER") ||
+                 is_keyword(start, length, "GROUP"))
+          is_order= true;
+        else if (is_keyword(start, length, "BY"))
+          level[depth].order_list= after_order;
+        else if (is_keyword(start, length, "LIMIT") ||
+                 is_keyword(start, length, "HAVING") ||
+                 is_keyword(start, length, "UNION") ||
+                 is_keyword(start, length, "INTO") ||
+                 is_keyword(start, length, "FOR") ||
+                 is_keyword(start, length, "LOCK") ||
+                 is_keyword(start, length, "PROCEDURE"))
+          level[depth].order_list= false;
+      }
+      else
+      {
+        enum_field_types type= MYSQL_TYPE_LONGLONG;
+        bool replace= length <= 18;
+
+        if (pos < end && *pos == '.')
+        {
+          /* Decimal number, or something else to keep as it is */
+          type= MYSQL_TYPE_NEWDECIMAL;
+          pos++;
+          replace= pos < end && my_isdigit(cs, *pos);
+          while (pos < end && is_word_char(cs, *pos))
+          {
+            if (!my_isdigit(cs, *pos))
+              replace= false;
+            pos++;
+          }
+          replace&= pos - start <= 60;
+        }
+        if (replace && !qualified && last != '-' && last != '+' &&
+            last != '~' && !level[depth].select_list &&
+            !level[depth].order_list)
+        {
+          Parse_cache_literal literal= { type, start, (size_t) (pos - start) };
+          if (literals->push_back(literal))
+            return true;
+          *to++= '?';
+          last= '?';
+          after_order= false;
+          continue;
+        }
+      }
+      memcpy(to, start, pos - start);
+      to+= pos - start;
+      last= pos[-1];
+      after_order= is_order;
+      continue;
+    }
+
+    after_order= false;
+
+    if (c == '\'' || (c == '"' && !ansi_quotes) ||
+        c == '`' || (c == '"' && ansi_quotes))
+    {
+      /* String literal or quoted identifier */
+      bool escaped= false;
+      uint l;
+
+      for (pos++; ; )
+      {
+        if (pos >= end)
+          return true;
+        if (use_mb(cs) && (l= my_ismbchar(cs, pos, end)))
+          pos+= l;
+        else if (c != '`' && *pos == '\\' && backslash_escapes)
+        {
+          if (pos + 1 >= end)
+            return true;
+          pos+= 2;
+          escaped= true;
+        }
+        else if (*pos == c)
+        {
+          if (pos + 1 < end && pos[1] == c)
+          {
+            pos+= 2;
+            escaped= true;
+            continue;
+          }
+          pos++;
+          break;
+        }
+        else
+          pos++;
+      }
+
+      const bool is_string= c == '\'' || (c == '"' && !ansi_quotes);
+      if (is_string && !level[depth].select_list &&
+          !level[depth].order_list && start > query.str &&
+          !is_word_char(cs, start[-1]) && start[-1] != '@')
+      {
+        Parse_cache_literal literal= { MYSQL_TYPE_VARCHAR, start + 1,
+                                       (size_t) (pos - start - 2) };
+        int well_formed_error;
+
+        if (escaped)
+        {
+          char *value= static_cast<char *>(thd->alloc(literal.length + 1));
+          if (value == NULL)
+            return true;
+          literal.length= unescape_string(thd, literal.str,
+                                          literal.str + literal.length,
+                                          c, value);
+          literal.str= value;
+        }
+        cs->cset->well_formed_len(cs, literal.str,
+                                  literal.str + literal.length,
+                                  literal.length, &well_formed_error);
+        if (!well_formed_error)
+        {
+          if (literals->push_back(literal))
+            return true;
+          *to++= '?';
+          last= '?';
+          continue;
+        }
+      }
+      memcpy(to, start, pos - start);
+      to+= pos - start;
+      last= c;
+      continue;
+    }
+
+    switch (c) {
+    case '#':
+    case ';':
+    case '?':
+    case '\\':
+      return true;
+    case '-':
+      if (pos + 1 < end && pos[1] == '-')
+        return true;
+      break;
+    case '/':
+      if (pos + 1 < end && pos[1] == '*')
+        return true;
+      break;
+    case '@':
+      if (pos + 1 < end && pos[1] == '@')
+        return true;
+      break;
+    case '(':
+      if (++depth == PARSE_CACHE_MAX_DEPTH)
+        return true;
+      /*
+        Arguments of functions and parenthesised expressions are part of
+        the clause they are in, a subquery starts its own select list.
+      */
+      level[depth]= level[depth - 1];
+      level[depth].query_block= false;
+      break;
+    case ')':
+      if (depth == 0)
+        return true;
+      depth--;
+      break;
+    }
+    *to++= *pos++;
+    last= c;
+  }
+
+  *text_length= to - text;
+  return !started;
+}
+
+
+/**
+  Whether a prepared statement can be executed for the queries it was
+  prepared for as they would be executed after parsing.
+*/
+
+static bool is_parse_cacheable(const LEX *lex)
+{
+  switch (lex->sql_command) {
+  case SQLCOM_SELECT:
+  case SQLCOM_INSERT:
+  case SQLCOM_INSERT_SELECT:
+  case SQLCOM_REPLACE:
+  case SQLCOM_REPLACE_SELECT:
+  case SQLCOM_UPDATE:
+  case SQLCOM_UPDATE_MULTI:
+  case SQLCOM_DELETE:
+  case SQLCOM_DELETE_MULTI:
+    return lex->keep_diagnostics == DA_KEEP_NOTHING && !lex->describe;
+  default:
+    return false;
+  }
+}
+
+
+/**
+  Prepare a statement of the parse cache.
+
+  @param thd          thread handle
+  @param text         text of the query with parameter markers
+  @param length       length of the text
+  @param[out] cache   whether to cache the result: the statement, or that
+                      the text can't be prepared as one
+
+  @return the statement, or NULL if the text can't be prepared as a
+          statement of the parse cache. No error is reported in this case.
+*/
+
+static Prepared_statement *prepare_for_parse_cache(THD *thd,
+                                                   const char *text,
+                                                   size_t length,
+                                                   bool *cache)
+{
+  Prepared_statement *stmt= new Prepared_statement(thd);
+  Diagnostics_area *da= thd->get_stmt_da();
+
+  *cache= false;
+  if (stmt == NULL)
+    return NULL;
+
+  stmt->set_sql_prepare();
+  stmt->set_parse_cache();
+
+  bool error= stmt->prepare(text, length);
+
+  /* Warnings of the parser would be lost at the next executions */
+  if (!error && is_parse_cacheable(stmt->lex) &&
+      da->current_statement_cond_count() == 0)
+  {
+    *cache= true;
+    return stmt;
+  }
+
+  /*
+    Remember the texts that can't be statements of the cache, but not
+    those which failed for other reasons, e.g. a table that does not
+    exist yet. The query is parsed as usual and reports the error.
+  */
+  *cache= !error || da->mysql_errno() == ER_PARSE_ERROR;
+  thd->clear_error();
+  da->reset_condition_info(thd);
+  delete stmt;
+  return NULL;
+}
+
+
+/**
+  Count a statement of the parse cache in prepared_stmt_count.
+
+  @return false if max_prepared_stmt_count is reached
+*/
+
+static bool reserve_prepared_stmt_count()
+{
+  bool reserved= false;
+
+  mysql_mutex_lock(&LOCK_prepared_stmt_count);
+  if (prepared_stmt_count < max_prepared_stmt_count)
+  {
+    prepared_stmt_count++;
+    reserved= true;
+  }
+  mysql_mutex_unlock(&LOCK_prepared_stmt_count);
+  return reserved;
+}
+
+
+static void release_prepared_stmt_count(ulong count)
+{
+  mysql_mutex_lock(&LOCK_prepared_stmt_count);
+  DBUG_ASSERT(prepared_stmt_count >= count);
+  prepared_stmt_count-= count;
+  mysql_mutex_unlock(&LOCK_prepared_stmt_count);
+}
+
+
+/** Assign the literals of a query to the parameters of its statement. */
+
+static bool set_params_from_literals(THD *thd, Prepared_statement *stmt,
+                                     const Parse_cache_literals &literals)
+{
+  if (stmt->param_count != literals.size())
+    return true;
+
+  for (uint i= 0; i < stmt->param_count; i++)
+  {
+    Item_param *param= stmt->param_array[i];
+    const Parse_cache_literal &literal= literals.at(i);
+
+    param->unsigned_flag= false;
+    switch (literal.type) {
+    case MYSQL_TYPE_LONGLONG:
+    {
+      char *end= const_cast<char *>(literal.str) + literal.length;
+      int error;
+      longlong value= my_strtoll10(literal.str, &end, &error);
+      setup_one_conversion_function(thd, param, MYSQL_TYPE_LONGLONG);
+      param->set_int(value, static_cast<uint32>(literal.length));
+      break;
+    }
+    case MYSQL_TYPE_NEWDECIMAL:
+      /* LIMIT accepts integers only, let the parser report it */
+      if (param->limit_clause_param)
+        return true;
+      setup_one_conversion_function(thd, param, MYSQL_TYPE_NEWDECIMAL);
+      param->set_decimal(literal.str, literal.length);
+      break;
+    default:
+      if (param->limit_clause_param)
+        return true;
+      setup_one_conversion_function(thd, param, MYSQL_TYPE_VARCHAR);
+      /* A literal has the collation of the connection */
+      param->value.cs_info.final_character_set_of_str_value=
+        thd->variables.collation_connection;
+      if (param->set_str(literal.str, literal.length) ||
+          param->convert_str_value(thd))
+        return true;
+      break;
+    }
+  }
+  return false;
+}
+
+
+Parse_cache::Parse_cache()
+{
+  m_statements.first= m_statements.last= NULL;
+  m_statements.count= 0;
+  m_failures= m_statements;
+
+  enum
+  {
+    START_HASH_SIZE= 16
+  };
+  my_hash_init(&m_hash, &my_charset_bin, START_HASH_SIZE, 0, 0,
+               get_parse_cache_key, free_parse_cache_entry, MYF(0),
+               key_memory_prepared_statement_map);
+}
+
+
+Prepared_statement *Parse_cache::find(THD *thd)
+{
+  const ulong size= thd->variables.parse_cache_size;
+
+  if (size == 0 || thd->slave_thread)
+  {
+    if (m_hash.records)
+      reset();
+    return NULL;
+  }
+
+  /*
+    The key is the text of the query with parameter markers, preceded by
+    the settings the statement depends on: the SQL mode and the character
+    sets, which change how the text is parsed, and the current database,
+    which the statement uses to execute.
+  */
+  const LEX_CSTRING query= thd->query();
+  const LEX_CSTRING db= thd->db();
+  const uint client_cs= thd->variables.character_set_client->number;
+  const uint connection_cl= thd->variables.collation_connection->number;
+  const size_t prefix_length= sizeof(sql_mode_t) + 2 * sizeof(uint) +
+                              db.length + 1;
+  char *key= static_cast<char *>(thd->alloc(prefix_length + query.length));
+  if (key == NULL)
+    return NULL;
+
+  char *text= key;
+  memcpy(text, &thd->variables.sql_mode, sizeof(sql_mode_t));
+  text+= sizeof(sql_mode_t);
+  memcpy(text, &client_cs, sizeof(uint));
+  text+= sizeof(uint);
+  memcpy(text, &connection_cl, sizeof(uint));
+  text+= sizeof(uint);
+  if (db.length)
+    memcpy(text, db.str, db.length);
+  text+= db.length;
+  *text++= 0;
+
+  Parse_cache_literals literals(thd->mem_root);
+  size_t text_length;
+  if (parameterize_query(thd, query, text, &text_length, &literals))
+    return NULL;
+  const size_t key_length= prefix_length + text_length;
+
+  Prepared_statement *stmt;
+  Parse_cache_entry *entry= reinterpret_cast<Parse_cache_entry *>
+    (my_hash_search(&m_hash, reinterpret_cast<uchar *>(key), key_length));
+  if (entry != NULL)
+  {
+    Lru_list *list= entry->stmt ? &m_statements : &m_failures;
+    unlink(list, entry);
+    link_first(list, entry);
+    if ((stmt= entry->stmt) == NULL)
+      return NULL;
+    thd->status_var.parse_cache_hits++;
+  }
+  else
+  {
+    bool cache;
+
+    thd->status_var.parse_cache_misses++;
+    stmt= prepare_for_parse_cache(thd, text, text_length, &cache);
+    if (!cache)
+      return NULL;
+
+    /*
+      Texts that can't be statements have their own list, so that they
+      don't take the places of statements.
+    */
+    Lru_list *list= stmt ? &m_statements : &m_failures;
+    while (list->count >= size)
+      evict(list);
+    /*
+      The statements take memory like those of the client: they are
+      counted in prepared_stmt_count and bounded by max_prepared_stmt_count.
+      The query is parsed as usual when the limit is reached.
+    */
+    if (stmt != NULL && !reserve_prepared_stmt_count())
+    {
+      delete stmt;
+      return NULL;
+    }
+    entry= static_cast<Parse_cache_entry *>
+      (my_malloc(key_memory_prepared_statement_map,
+                 sizeof(Parse_cache_entry) + key_length, MYF(0)));
+    if (entry == NULL)
+    {
+      if (stmt != NULL)
+        release_prepared_stmt_count(1);
+      delete stmt;
+      return NULL;
+    }
+    entry->stmt= stmt;
+    entry->key_length= key_length;
+    entry->key= reinterpret_cast<char *>(entry + 1);
+    memcpy(entry->key, key, key_length);
+    if (my_hash_insert(&m_hash, reinterpret_cast<uchar *>(entry)))
+    {
+      if (stmt != NULL)
+        release_prepared_stmt_count(1);
+      free_parse_cache_entry(entry);
+      return NULL;
+    }
+    link_first(list, entry);
+    if (stmt == NULL)
+      return NULL;
+  }
+
+  if (set_params_from_literals(thd, stmt, literals))
+    return NULL;
+
+  /* Report the digest the parser would have computed */
+  if (thd->m_digest != NULL)
+  {
+    PSI_digest_locker *locker= MYSQL_DIGEST_START(thd->m_statement_psi);
+
+    thd->m_digest->m_digest_storage.copy(&stmt->m_digest);
+    if (locker != NULL)
+      MYSQL_DIGEST_END(locker, &thd->m_digest->m_digest_storage);
+  }
+  return stmt;
+}
+
+
+bool Parse_cache::execute(THD *thd, Prepared_statement *statement)
+{
+  /* The query is logged and replicated as it was received */
+  String expanded_query(thd->query().str, thd->query().length,
+                        thd->charset());
+
+  return statement->execute_bound(&expanded_query, false);
+}
+
+
+void Parse_cache::link_first(Lru_list *list, Parse_cache_entry *entry)
+{
+  entry->lru_prev= NULL;
+  entry->lru_next= list->first;
+  if (list->first != NULL)
+    list->first->lru_prev= entry;
+  else
+    list->last= entry;
+  list->first= entry;
+  list->count++;
+}
+
+
+void Parse_cache::unlink(Lru_list *list, Parse_cache_entry *entry)
+{
+  if (entry->lru_prev != NULL)
+    entry->lru_prev->lru_next= entry->lru_next;
+  else
+    list->first= entry->lru_next;
+  if (entry->lru_next != NULL)
+    entry->lru_next->lru_prev= entry->lru_prev;
+  else
+    list->last= entry->lru_prev;
+  list->count--;
+}
+
+
+/** Delete the least recently used entry of a list. */
+
+void Parse_cache::evict(Lru_list *list)
+{
+  Parse_cache_entry *lru= list->last;
+
+  DBUG_ASSERT(lru != NULL);
+  unlink(list, lru);
+  if (lru->stmt != NULL)
+    release_prepared_stmt_count(1);
+  my_hash_delete(&m_hash, reinterpret_cast<uchar *>(lru));
+}
+
+
+void Parse_cache::claim_memory_ownership()
+{
+  my_hash_claim(&m_hash);
+}
+
+
+void Parse_cache::reset()
+{
+  if (m_statements.count > 0)
+    release_prepared_stmt_count(m_statements.count);
+  my_hash_reset(&m_hash);
+  m_statements.first= m_statements.last= NULL;
+  m_statements.count= 0;
+  m_failures= m_statements;
+}
+
+
+Parse_cache::~Parse_cache()
+{
+  /* reset() should already have been called while the THD is valid */
+  DBUG_ASSERT(m_hash.records == 0);
+
+  my_hash_free(&m_hash);
+}
+
+
 /***************************************************************************
 * Ed_result_set
 ***************************************************************************/
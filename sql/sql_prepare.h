@@ -398,7 +398,8 @@ class Prepared_statement: public Query_arena
   enum flag_values
   {
     IS_IN_USE= 1,
-    IS_SQL_PREPARE= 2
+    IS_SQL_PREPARE= 2,
+    IS_PARSE_CACHE= 4
   };
 
 public:
@@ -425,6 +426,12 @@ public:
   /* Performance Schema interface for a prepared statement. */
   PSI_prepared_stmt* m_prepared_stmt;
 
+  /**
+    Digest of the statement, computed for statements of the parse cache.
+    The token array is allocated in the statement memory root.
+  */
+  sql_digest_storage m_digest;
+
 private:
   Query_fetch_protocol_binary result;
   uint flags;
@@ -460,10 +467,18 @@ public:
   bool is_in_use() const { return flags & (uint) IS_IN_USE; }
   bool is_sql_prepare() const { return flags & (uint) IS_SQL_PREPARE; }
   void set_sql_prepare() { flags|= (uint) IS_SQL_PREPARE; }
+  bool is_parse_cache() const { return flags & (uint) IS_PARSE_CACHE; }
+  void set_parse_cache() { flags|= (uint) IS_PARSE_CACHE; }
   bool prepare(const char *packet, size_t packet_length);
   bool execute_loop(String *expanded_query,
                     bool open_cursor,
-                    uchar *packet_arg, uchar *packet_end_arg);
+                    uchar *packet_arg, uchar *packet_end_arg,
+                    uchar **packet_next= NULL);
+  bool execute_bound(String *expanded_query, bool open_cursor);
+#ifndef EMBEDDED_LIBRARY
+  bool execute_batch(String *expanded_query,
+                     uchar *packet, uchar *packet_end);
+#endif
   bool execute_server_runnable(Server_runnable *server_runnable);
 #ifdef HAVE_PSI_PS_INTERFACE
   PSI_prepared_stmt* get_PS_prepared_stmt();
@@ -474,7 +489,7 @@ private:
   void setup_set_params();
   bool set_db(const LEX_CSTRING &db_length);
   bool set_parameters(String *expanded_query,
-                      uchar *packet, uchar *packet_end);
+                      uchar **packet, uchar *packet_end);
   bool execute(String *expanded_query, bool open_cursor);
   bool reprepare();
   bool validate_metadata(Prepared_statement  *copy);
@@ -482,7 +497,7 @@ private:
   bool insert_params_from_vars(List<LEX_STRING>& varnames,
                                String *query);
 #ifndef EMBEDDED_LIBRARY
-  bool insert_params(uchar *null_array, uchar *read_pos, uchar *data_end,
+  bool insert_params(uchar *null_array, uchar **read_pos, uchar *data_end,
                      String *query);
 #else
   bool emb_insert_params(String *query);
@@ -877,6 +877,65 @@ void JOIN::reset()
 }
 
 
+/**
+  Check whether a materializable derived table can be streamed, i.e.
+  joined as its query expression produces the rows, @see QEP_TAB::streamed.
+
+  This is the case when the derived table is the first non-const table of
+  the plan, is read once with a plain table scan and its rows are never
+  needed again after having been joined: no sorting, no row IDs, no outer
+  join or semi-join strategy, and the query is not a subquery which may be
+  executed several times.
+
+  @param join the join reading the derived table
+  @param tl   the derived table
+
+  @return true if the derived table can be streamed
+*/
+
+static bool can_stream_derived(JOIN *join, TABLE_LIST *tl)
+{
+  THD *const thd= join->thd;
+
+  if (!thd->optimizer_switch_flag(OPTIMIZER_SWITCH_DERIVED_STREAMING) ||
+      thd->lex->describe || thd->lex->sql_command != SQLCOM_SELECT ||
+      join->qep_tab == NULL || join->plan_is_const())
+    return false;
+
+  for (SELECT_LEX *sl= join->select_lex; sl != NULL; sl= sl->outer_select())
+  {
+    if (sl->master_unit()->item != NULL)
+      return false;
+  }
+
+  /*
+    UNION DISTINCT and a global ORDER BY or LIMIT are evaluated by the
+    "fake" query block over a temporary table; UNION ALL sends the rows of
+    every query block straight to the derived table result.
+  */
+  SELECT_LEX_UNIT *const unit= tl->derived_unit();
+  if (unit->is_union() && unit->fake_select_lex != NULL)
+    return false;
+
+  if (tl->materializable_is_const())
+    return false;
+
+  const QEP_TAB *const tab= tl->table->reginfo.qep_tab;
+  return tab == join->qep_tab + join->const_tables &&
+         tab->type() == JT_ALL &&
+         tab->quick() == NULL &&
+         tab->filesort == NULL &&
+         !tab->dynamic_range() &&
+         !tab->keep_current_rowid &&
+         tab->first_inner() == NO_PLAN_IDX &&
+         tab->first_sj_inner() == NO_PLAN_IDX &&
+         !tab->starts_weedout() &&
+         tab->check_weed_out_table == NULL &&
+         !tab->do_firstmatch() &&
+         !tab->do_loosescan();
+}
+
+
 /**
   Prepare join result.
 
@@ -898,7 +957,13 @@ bool JOIN::prepare_result()
   {
     for (TABLE_LIST *tl= select_lex->leaf_tables; tl; tl= tl->next_leaf)
     {
-      if (tl->is_view_or_derived() && tl->create_derived(thd))
+      if (!tl->is_view_or_derived())
+        continue;
+      // A streamed derived table is read without instantiating its table
+      QEP_TAB *const tab= tl->table->reginfo.qep_tab;
+      if (tab != NULL && (tab->streamed= can_stream_derived(this, tl)))
+        continue;
+      if (tl->create_derived(thd))
         goto err;                 /* purecov: inspected */
     }
   }
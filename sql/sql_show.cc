@@ -66,6 +66,10 @@
 #include "mysql/psi/mysql_file.h"
 #ifndef EMBEDDED_LIBRARY
 #include "srv_session.h"
+
+#ifdef HAVE_POOL_OF_THREADS
+#include "threadpool.h"                     // tp_get_group_stats
+#endif
 #endif
 
 #include <algorithm>
@@ -3331,6 +3335,44 @@ int fill_schema_thread_stats(THD* thd, TABLE_LIST* tables, Item* cond)
   DBUG_RETURN(1);
 }
 
+/**
+  Fill INFORMATION_SCHEMA.THREAD_POOL_GROUPS with the state of the thread
+  groups of the thread pool. The table is empty if the thread pool is not
+  in use.
+*/
+
+int fill_schema_thread_pool_groups(THD *thd, TABLE_LIST *tables, Item *cond)
+{
+  DBUG_ENTER("fill_schema_thread_pool_groups");
+
+  if (check_global_access(thd, PROCESS_ACL))
+    DBUG_RETURN(1);
+
+#if defined(HAVE_POOL_OF_THREADS) && !defined(_WIN32)
+  TABLE *table= tables->table;
+  TP_GROUP_STATS stats;
+  for (uint i= 0; tp_get_group_stats(i, &stats); i++)
+  {
+    restore_record(table, s->default_values);
+    table->field[0]->store(i, TRUE);
+    table->field[1]->store(stats.connection_count, TRUE);
+    table->field[2]->store(stats.thread_count, TRUE);
+    table->field[3]->store(stats.active_thread_count, TRUE);
+    table->field[4]->store(stats.waiting_thread_count, TRUE);
+    table->field[5]->store(stats.queue_length, TRUE);
+    table->field[6]->store(stats.high_prio_queue_length, TRUE);
+    table->field[7]->store(stats.long_queue_length, TRUE);
+    table->field[8]->store(stats.stolen_event_count, TRUE);
+    table->field[9]->store(stats.numa_node, FALSE);
+    table->field[10]->store(stats.stalled ? "YES" : "NO",
+                           stats.stalled ? 3 : 2, system_charset_info);
+    if (schema_table_store_record(thd, table))
+      DBUG_RETURN(1);
+  }
+#endif
+  DBUG_RETURN(0);
+}
+
 // Sends the global table stats back to the client.
 int fill_schema_table_stats(THD* thd, TABLE_LIST* tables, Item* cond)
 {
@@ -9536,6 +9578,32 @@ ST_FIELD_INFO client_stats_fields_info[]=
   {0, 0, MYSQL_TYPE_STRING, 0, 0, 0, 0}
 };
 
+ST_FIELD_INFO thread_pool_groups_fields_info[]=
+{
+  {"GROUP_ID", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"CONNECTIONS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"THREADS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"ACTIVE_THREADS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"WAITING_THREADS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"QUEUE_LENGTH", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"HIGH_PRIO_QUEUE_LENGTH", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG,
+   0, MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"LONG_QUEUE_LENGTH", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"STOLEN_EVENTS", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
+   MY_I_S_UNSIGNED, 0, SKIP_OPEN_TABLE},
+  {"NUMA_NODE", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0, 0, 0,
+   SKIP_OPEN_TABLE},
+  {"STALLED", 3, MYSQL_TYPE_STRING, 0, 0, 0, SKIP_OPEN_TABLE},
+  {0, 0, MYSQL_TYPE_STRING, 0, 0, 0, 0}
+};
+
 ST_FIELD_INFO thread_stats_fields_info[]=
 {
   {"THREAD_ID", MY_INT64_NUM_DECIMAL_DIGITS, MYSQL_TYPE_LONGLONG, 0,
@@ -9895,6 +9963,8 @@ ST_SCHEMA_TABLE schema_tables[]=
   {"TEMPORARY_TABLES", temporary_table_fields_info, create_schema_table,
    fill_temporary_tables, make_temporary_tables_old_format, 0, 2, 3, 0,
    OPEN_TABLE_ONLY|OPTIMIZE_I_S_TABLE},
+  {"THREAD_POOL_GROUPS", thread_pool_groups_fields_info, create_schema_table,
+   fill_schema_thread_pool_groups, 0, 0, -1, -1, 0, 0},
   {"THREAD_STATISTICS", thread_stats_fields_info, create_schema_table,
     fill_schema_thread_stats, make_old_format, 0, -1, -1, 0, 0},
   {"TRIGGERS", triggers_fields_info, create_schema_table,
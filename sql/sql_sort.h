@@ -34,6 +34,10 @@ class Filesort;
 
 #define MERGEBUFF		7
 #define MERGEBUFF2		15
+/* Max bytes of records in a frame of a compressed spill file */
+#define SPILL_FRAME_SIZE	(64U * 1024U)
+/* Compressed length, uncompressed length and number of records */
+#define SPILL_FRAME_HEADER_SIZE	12
 
 /* Structs used when sorting */
 
@@ -298,6 +302,20 @@ public:
   ha_rows examined_rows;      // Number of examined rows.
   TABLE *sort_form;           // For quicker make_sortkey.
   bool use_hash;              // Whether to use hash to distinguish cut JSON
+  uint sort_threads;          // Max threads to sort a buffer with.
+  ulonglong sort_time;        // Microseconds spent sorting buffers.
+
+  /**
+    Spilled chunks are written as LZ4 compressed frames of at most this
+    many records, or uncompressed if it is 0. See write_spill_record().
+  */
+  uint spill_frame_max_records;
+  uint spill_frame_records;   // Records in the frame being written.
+  uchar *spill_frame;         // Frame being written, NULL until needed.
+  uchar *spill_frame_end;     // End of the records in spill_frame.
+  uchar *spill_compressed;    // Compressed frame being written or read.
+  ulonglong spill_bytes;      // Bytes of records written to spill files.
+  ulonglong spill_disk_bytes; // Bytes written to spill files.
 
   /**
     ORDER BY list with some precalculated info for filesort.
@@ -689,6 +689,12 @@ create_tmp_table(THD *thd, Temp_table_param *param, List<Item> &fields,
   */
   uint total_uneven_bit_length= 0, hidden_uneven_bit_length= 0;
   bool force_copy_fields= param->force_copy_fields;
+  /*
+    With dynamic rows, the heap engine stores blobs in variable-size
+    chunks, so they do not force the table to disk.
+  */
+  const bool heap_dynamic_rows= thd->variables.internal_tmp_mem_row_format ==
+                                TMP_TABLE_ROW_FORMAT_DYNAMIC;
 
   uint max_key_length;
   uint max_key_part_length;
@@ -1073,7 +1079,7 @@ update_hidden:
     table->file= get_new_handler(share, &table->mem_root,
                                  share->db_type());
   }
-  else if (blob_count ||
+  else if ((blob_count && !heap_dynamic_rows) ||
            (thd->variables.big_tables &&
             !(select_options & SELECT_SMALL_RESULT)))
   {
@@ -1101,6 +1107,8 @@ update_hidden:
     share->db_plugin= ha_lock_engine(0, heap_hton);
     table->file= get_new_handler(share, &table->mem_root,
                                  share->db_type());
+    if (heap_dynamic_rows)
+      share->row_type= ROW_TYPE_DYNAMIC;
   }
 
   /*
@@ -1418,7 +1426,12 @@ update_hidden:
   param->recinfo=recinfo;
   store_record(table,s->default_values);        // Make empty default record
 
-  if (thd->variables.tmp_table_size == ~ (ulonglong) 0)		// No limit
+  /*
+    Rows of dynamic heap tables take less than reclength, so their number
+    is not limited here: the heap engine limits the memory they take.
+  */
+  if (thd->variables.tmp_table_size == ~ (ulonglong) 0 ||	// No limit
+      share->row_type == ROW_TYPE_DYNAMIC)
     share->max_rows= ~(ha_rows) 0;
   else
     share->max_rows= (ha_rows) (((share->db_type() == heap_hton) ?
@@ -2328,6 +2341,8 @@ static void trace_tmp_table(Opt_trace_context *trace, const TABLE *table)
     DBUG_ASSERT(table->s->db_type() == heap_hton);
     trace_tmp.add_alnum("location", "memory (heap)").
       add("row_limit_estimate", table->s->max_rows);
+    if (table->s->row_type == ROW_TYPE_DYNAMIC)
+      trace_tmp.add_alnum("record_format", "dynamic");
   }
 }
 
@@ -2508,6 +2523,8 @@ bool create_ondisk_from_heap(THD *thd, TABLE *table,
   new_table= *table;
   share= *table->s;
   share.ha_share= NULL;
+  /* Dynamic rows are a heap engine format */
+  share.row_type= ROW_TYPE_DEFAULT;
   new_table.s= &share;
   switch (internal_tmp_disk_storage_engine)
   {
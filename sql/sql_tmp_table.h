@@ -49,6 +49,12 @@ typedef Mem_root_array<Item*, true> Func_ptr_array;
  */
 enum enum_internal_tmp_disk_storage_engine { TMP_TABLE_MYISAM, TMP_TABLE_INNODB };
 
+/*
+   For session system variable internal_tmp_mem_row_format
+ */
+enum enum_internal_tmp_mem_row_format
+{ TMP_TABLE_ROW_FORMAT_FIXED, TMP_TABLE_ROW_FORMAT_DYNAMIC };
+
 TABLE *
 create_tmp_table(THD *thd, Temp_table_param *param, List<Item> &fields,
 		 ORDER *group, bool distinct, bool save_sum_fields,
@@ -56,6 +56,9 @@ bool Query_result_union::send_data(List<Item> &values)
   if (fill_record(thd, table, table->visible_field_ptr(), values, NULL, NULL))
     return true;                /* purecov: inspected */
 
+  if (stream_tab != NULL)
+    return stream_derived_record(stream_tab);
+
   if (!check_unique_constraint(table))
     return false;
 
@@ -83,6 +86,8 @@ bool Query_result_union::send_eof()
 
 bool Query_result_union::flush()
 {
+  if (stream_tab != NULL)
+    return false;
   const int error= table->file->extra(HA_EXTRA_NO_CACHE);
   if (error)
   {
@@ -151,7 +156,8 @@ bool Query_result_union::create_result_table(THD *thd_arg,
 
 void Query_result_union::cleanup()
 {
-  if (table == NULL)
+  // A streamed derived table is never instantiated
+  if (table == NULL || !table->is_created())
     return;
   table->file->extra(HA_EXTRA_RESET_STATE);
   if (table->hash_field)
@@ -20,6 +20,7 @@
 #include "sql_class.h"          // Query_result_interceptor
 
 struct LEX;
+class QEP_TAB;
 
 typedef class st_select_lex_unit SELECT_LEX_UNIT;
 
@@ -29,9 +30,15 @@ class Query_result_union :public Query_result_interceptor
 public:
   TABLE *table;
   bool is_union_mixed_with_union_all; // Mark the mixed operation
+  /**
+    For a streamed derived table: the table being read by the outer join,
+    rows are passed to it instead of being written to the temporary table.
+    @see QEP_TAB::streamed
+  */
+  QEP_TAB *stream_tab;
 
   Query_result_union() :table(0),
-  is_union_mixed_with_union_all(false){}
+  is_union_mixed_with_union_all(false), stream_tab(NULL) {}
   int prepare(List<Item> &list, SELECT_LEX_UNIT *u);
   /**
     Do prepare() and prepare2() if they have been postponed until
@@ -2731,6 +2731,32 @@ static Sys_var_ulong Sys_net_write_timeout(
        NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_net_write_timeout));
 
+static bool fix_protocol_compression_level(sys_var *self, THD *thd,
+                                           enum_var_type type)
+{
+  if (type != OPT_GLOBAL && thd->is_classic_protocol())
+    my_net_set_compression_level(thd->get_protocol_classic()->get_net(),
+                                 thd->variables.protocol_compression_level);
+  return false;
+}
+static Sys_var_ulong Sys_protocol_compression_level(
+       "protocol_compression_level",
+       "Level of the LZ4 compression of the packets sent to clients that "
+       "negotiated it, from 1 (fastest) to 9 (best compression). Has no "
+       "effect on zlib compressed connections",
+       SESSION_VAR(protocol_compression_level), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 9), DEFAULT(NET_COMPRESSION_DEFAULT_LEVEL),
+       BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_protocol_compression_level));
+
+static Sys_var_mybool Sys_protocol_compression_lz4(
+       "protocol_compression_lz4",
+       "Offer LZ4 compression of the client/server protocol to clients "
+       "that request compression. Clients that do not support it keep "
+       "using zlib",
+       READ_ONLY GLOBAL_VAR(opt_protocol_compression_lz4),
+       CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 // Sync kill_idle_transaction and innodb_kill_idle_transaction values
 extern long srv_kill_idle_transaction;
 
@@ -2878,6 +2904,15 @@ limit_parser_max_mem_size(sys_var *self, THD *thd, set_var *var)
   return false;
 }
 
+static Sys_var_ulong Sys_parse_cache_size(
+       "parse_cache_size",
+       "Maximum number of statements per connection that are kept prepared "
+       "for the text of queries with their literals replaced by parameters, "
+       "and executed for the next queries with the same text. 0 disables "
+       "the cache",
+       SESSION_VAR(parse_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 65536), DEFAULT(0), BLOCK_SIZE(1));
+
 // Similar to what we do for the intptr typedef.
 #if SIZEOF_CHARP == SIZEOF_INT
 static unsigned int max_mem_sz = ~0;
@@ -2942,7 +2977,8 @@ static const char *optimizer_switch_names[]=
   "materialization", "semijoin", "loosescan", "firstmatch", "duplicateweedout",
   "subquery_materialization_cost_based",
   "use_index_extensions", "condition_fanout_filter", "derived_merge",
-  "default", NullS
+  "hash_join", "hash_group_by", "derived_streaming", "plan_cache",
+  "compiled_conditions", "default", NullS
 };
 static Sys_var_flagset Sys_optimizer_switch(
        "optimizer_switch",
@@ -2953,8 +2989,10 @@ static Sys_var_flagset Sys_optimizer_switch(
        ", materialization, semijoin, loosescan, firstmatch, duplicateweedout,"
        " subquery_materialization_cost_based"
        ", block_nested_loop, batched_key_access, use_index_extensions,"
-       " condition_fanout_filter, derived_merge} and val is one of "
-       "{on, off, default}",
+       " condition_fanout_filter, derived_merge, hash_join, hash_group_by,"
+       " derived_streaming, plan_cache, compiled_conditions}"
+       " and val is one"
+       " of {on, off, default}",
        SESSION_VAR(optimizer_switch), CMD_LINE(REQUIRED_ARG),
        optimizer_switch_names, DEFAULT(OPTIMIZER_SWITCH_DEFAULT),
        NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(NULL), ON_UPDATE(NULL));
@@ -3372,6 +3410,14 @@ static Sys_var_ulong Sys_query_prealloc_size(
        BLOCK_SIZE(1024), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_thd_mem_root));
 
+static Sys_var_ulong Sys_query_alloc_keep_size(
+       "query_alloc_keep_size",
+       "Memory for query parsing and execution, besides the persistent "
+       "buffer, that is kept for the next statements instead of being freed "
+       "after each statement. 0 frees it after each statement",
+       SESSION_VAR(query_alloc_keep_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONG_MAX), DEFAULT(0), BLOCK_SIZE(1024));
+
 #if defined (_WIN32) && !defined (EMBEDDED_LIBRARY)
 static Sys_var_mybool Sys_shared_memory(
        "shared_memory", "Enable the shared memory",
@@ -3631,6 +3677,13 @@ static Sys_var_mybool Sys_slave_compressed_protocol(
        GLOBAL_VAR(opt_slave_compressed_protocol), CMD_LINE(OPT_ARG),
        DEFAULT(FALSE));
 
+static Sys_var_mybool Sys_slave_compression_lz4(
+       "slave_compression_lz4",
+       "Request LZ4 instead of zlib compression from the master when "
+       "slave_compressed_protocol is on. Used only if the master offers it",
+       GLOBAL_VAR(opt_slave_compression_lz4), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 #ifdef HAVE_REPLICATION
 static const char *slave_exec_mode_names[]=
        {"STRICT", "IDEMPOTENT", 0};
@@ -3809,6 +3862,21 @@ static Sys_var_ulong Sys_sort_buffer(
        VALID_RANGE(MIN_SORT_MEMORY, ULONG_MAX), DEFAULT(DEFAULT_SORT_MEMORY),
        BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_sort_threads(
+       "sort_threads",
+       "Maximum number of threads that sort each sort buffer. With more than "
+       "one thread, the time spent in each phase of the sort is also written "
+       "to the optimizer trace",
+       SESSION_VAR(sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 64), DEFAULT(1), BLOCK_SIZE(1));
+
+static Sys_var_mybool Sys_sort_spill_compression(
+       "sort_spill_compression",
+       "Compress the sorted chunks that a sort writes to temporary files "
+       "with LZ4",
+       SESSION_VAR(sort_spill_compression), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 /**
   Check sql modes strict_mode, 'NO_ZERO_DATE', 'NO_ZERO_IN_DATE' and
   'ERROR_FOR_DIVISION_BY_ZERO' are used together. If only subset of it
@@ -4251,6 +4319,36 @@ static Sys_var_enum Sys_threadpool_high_prio_mode(
   SESSION_VAR(threadpool_high_prio_mode), CMD_LINE(REQUIRED_ARG),
   threadpool_high_prio_mode_names, DEFAULT(TP_HIGH_PRIO_MODE_TRANSACTIONS));
 
+static Sys_var_mybool Sys_threadpool_work_stealing(
+  "thread_pool_work_stealing",
+  "Let the workers of a thread group which has no events to handle take "
+  "queued events of busy thread groups, moving the connections over to "
+  "their group.",
+  GLOBAL_VAR(threadpool_work_stealing), CMD_LINE(OPT_ARG), DEFAULT(TRUE));
+
+static Sys_var_mybool Sys_threadpool_numa_affinity(
+  "thread_pool_numa_affinity",
+  "Run the worker threads of each thread group on the CPUs of one NUMA "
+  "node, spreading the thread groups over the nodes. Has no effect if the "
+  "server is built without NUMA support.",
+  READ_ONLY GLOBAL_VAR(threadpool_numa_affinity), CMD_LINE(OPT_ARG),
+  DEFAULT(FALSE));
+
+static Sys_var_uint Sys_threadpool_long_request_time(
+  "thread_pool_long_request_time",
+  "Connections whose recent requests took longer than this many "
+  "milliseconds on average queue their next requests behind the short "
+  "requests of other connections. 0 disables the long queue.",
+  GLOBAL_VAR(threadpool_long_request_time), CMD_LINE(REQUIRED_ARG),
+  VALID_RANGE(0, UINT_MAX), DEFAULT(1000), BLOCK_SIZE(1));
+
+static Sys_var_uint Sys_threadpool_short_queue_weight(
+  "thread_pool_short_queue_weight",
+  "Number of queued short requests a thread group handles before it "
+  "handles one queued long request.",
+  GLOBAL_VAR(threadpool_short_queue_weight), CMD_LINE(REQUIRED_ARG),
+  VALID_RANGE(1, 1000), DEFAULT(4), BLOCK_SIZE(1));
+
 #endif /* !WIN32 */
 static Sys_var_uint Sys_threadpool_max_threads(
   "thread_pool_max_threads",
@@ -4577,6 +4675,18 @@ static Sys_var_enum Sys_internal_tmp_disk_storage_engine(
        GLOBAL_VAR(internal_tmp_disk_storage_engine), CMD_LINE(OPT_ARG),
        internal_tmp_disk_storage_engine_names, DEFAULT(TMP_TABLE_INNODB));
 
+static const char *internal_tmp_mem_row_format_names[]=
+  { "FIXED", "DYNAMIC", 0 };
+static Sys_var_enum Sys_internal_tmp_mem_row_format(
+       "internal_tmp_mem_row_format",
+       "The row format of in-memory internal tmp tables. With DYNAMIC, rows "
+       "are stored in variable-size chunks instead of being padded to the "
+       "full length of their VARCHAR columns, and tmp tables with BLOB or "
+       "TEXT columns are kept in memory instead of being created on disk",
+       SESSION_VAR(internal_tmp_mem_row_format), CMD_LINE(REQUIRED_ARG),
+       internal_tmp_mem_row_format_names,
+       DEFAULT(TMP_TABLE_ROW_FORMAT_FIXED));
+
 static Sys_var_plugin Sys_default_tmp_storage_engine(
        "default_tmp_storage_engine", "The default storage engine for new explicit temporary tables",
        SESSION_VAR(temp_table_plugin), NO_CMD_LINE,
@@ -40,6 +40,7 @@ class COND_EQUAL;
 class Security_context;
 class ACL_internal_schema_access;
 class ACL_internal_table_access;
+class Table_cache;
 class Table_cache_element;
 class Table_trigger_dispatcher;
 class Query_result_union;
@@ -1021,6 +1022,8 @@ private:
 public:
 
   THD	*in_use;                        /* Which thread uses this */
+  /* Table cache instance containing this TABLE object */
+  Table_cache *cache_instance;
   Field **field;			/* Pointer to fields */
   /// Count of hidden fields, if internal temporary table; 0 otherwise.
   uint hidden_field_count;
@@ -20,6 +20,10 @@
 #include "sql_class.h"
 #include "sql_base.h"
 
+#ifdef HAVE_SCHED_GETCPU
+#include <sched.h>
+#endif
+
 /**
   Cache for open TABLE objects.
 
@@ -27,8 +31,10 @@
   go to a central table definition cache to get a TABLE object and
   therefore don't need to lock LOCK_open mutex.
   Instead they only need to go to one Table_cache instance (the
-  specific instance is determined by thread id) and only lock the
-  mutex protecting this cache.
+  specific instance is determined by the CPU the thread runs on, or by
+  thread id where this is not known) and only lock the mutex protecting
+  this cache. Each TABLE object remembers the instance containing it,
+  so that it is returned there when closed.
   DDL statements that need to remove all TABLE objects from all caches
   need to lock mutexes for all Table_cache instances, but they are rare.
 
@@ -161,6 +167,24 @@ public:
     return &m_table_cache[thd->thread_id() % table_cache_instances];
   }
 
+  /**
+    Get instance of table cache in which particular connection should
+    look for TABLE objects when opening tables and add the new ones.
+
+    This is the instance for the CPU the thread runs on, so that
+    concurrently executing statements rarely contend for the same
+    instance lock, however many connections there are.
+  */
+  Table_cache* get_local_cache(THD *thd)
+  {
+#ifdef HAVE_SCHED_GETCPU
+    int cpu= sched_getcpu();
+    if (cpu >= 0)
+      return &m_table_cache[cpu % table_cache_instances];
+#endif
+    return get_cache(thd);
+  }
+
   /** Get index for the table cache in container. */
   uint cache_index(Table_cache *cache) const
   {
@@ -388,6 +412,7 @@ bool Table_cache::add_used_table(THD *thd, TABLE *table)
 
   /* Add table to the used tables list */
   el->used_tables.push_front(table);
+  table->cache_instance= this;
 
   m_table_count++;
 
@@ -34,6 +34,10 @@ extern uint threadpool_size; /* Number of parallel executing threads */
 extern uint threadpool_stall_limit;  /* time interval in 10 ms units for stall checks*/
 extern uint threadpool_max_threads;  /* Maximum threads in pool */
 extern uint threadpool_oversubscribe;  /* Maximum active threads in group */
+extern my_bool threadpool_work_stealing; /* Idle groups take events of busy ones */
+extern my_bool threadpool_numa_affinity; /* Bind thread groups to NUMA nodes */
+extern uint threadpool_long_request_time; /* Requests slower than this, in ms, are long */
+extern uint threadpool_short_queue_weight; /* Short events taken per long one */
 
 /* Possible values for thread_pool_high_prio_mode */
 extern const char *threadpool_high_prio_mode_names[];
@@ -70,6 +74,28 @@ struct TP_STATISTICS
 
 extern TP_STATISTICS tp_stats;
 
+/*
+  State of one thread group, for INFORMATION_SCHEMA.THREAD_POOL_GROUPS
+*/
+struct TP_GROUP_STATS
+{
+  int connection_count;
+  int thread_count;
+  int active_thread_count;
+  int waiting_thread_count;
+  uint queue_length;
+  uint high_prio_queue_length;
+  /* Events of connections whose requests are predicted to be long */
+  uint long_queue_length;
+  /* Events the workers of the group took from other groups */
+  ulonglong stolen_event_count;
+  /* NUMA node the workers are bound to, -1 if none */
+  int numa_node;
+  bool stalled;
+};
+
+extern bool tp_get_group_stats(uint group_id, TP_GROUP_STATS *stats);
+
 
 /* Functions to set threadpool parameters */
 extern void tp_set_min_threads(uint val);
@@ -36,6 +36,10 @@ uint threadpool_size;
 uint threadpool_stall_limit;
 uint threadpool_max_threads;
 uint threadpool_oversubscribe;
+my_bool threadpool_work_stealing;
+my_bool threadpool_numa_affinity;
+uint threadpool_long_request_time;
+uint threadpool_short_queue_weight;
 
 /* Stats */
 TP_STATISTICS tp_stats;
@@ -25,6 +25,9 @@
 #include <mysql/thread_pool_priv.h>             // thd_is_transaction_active()
 #include <time.h>
 #include <mysqld_thd_manager.h>
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#endif
 #ifdef __linux__
 #include <sys/epoll.h>
 typedef struct epoll_event native_event;
@@ -123,13 +126,15 @@ struct connection_t
   bool bound_to_poll_descriptor;
   bool waiting;
   uint tickets;
+  /* Moving average of the time its requests took to handle, microseconds */
+  ulonglong avg_request_time;
 };
 
 typedef I_P_List<connection_t,
                      I_P_List_adapter<connection_t,
                                       &connection_t::next_in_queue,
                                       &connection_t::prev_in_queue>,
-                     I_P_List_null_counter,
+                     I_P_List_counter,
                      I_P_List_fast_push_back<connection_t> >
 connection_queue_t;
 
@@ -138,6 +143,8 @@ struct thread_group_t
   mysql_mutex_t mutex;
   connection_queue_t queue;
   connection_queue_t high_prio_queue;
+  /* Low priority events of connections which run long requests */
+  connection_queue_t long_queue;
   worker_list_t waiting_threads; 
   worker_thread_t *listener;
   pthread_attr_t *pthread_attr;
@@ -150,6 +157,12 @@ struct thread_group_t
   int io_event_count;
   int queue_event_count;
   ulonglong last_thread_creation_time;
+  /* Events taken from the queues of other groups */
+  ulonglong stolen_event_count;
+  /* NUMA node the workers run on, -1 if they are not bound */
+  int  numa_node;
+  /* Events taken from queue since the last one from long_queue */
+  uint short_event_streak;
   int  shutdown_pipe[2];
   bool shutdown;
   bool stalled;
@@ -447,8 +460,42 @@ inline bool connection_is_high_prio(const connection_t *c)
       c->thd->mdl_context.has_locks(MDL_key::LOCKING_SERVICE)));
 }
 
+/*
+   Checks if the requests of a connection are predicted to be long, judging
+   by the time its recent requests took. Such connections wait in the long
+   queue, so that they do not hold up the short requests of others.
+*/
+
+inline bool connection_is_long(const connection_t *c)
+{
+  return (threadpool_long_request_time != 0 &&
+          c->avg_request_time >= threadpool_long_request_time * 1000ULL);
+}
+
 } // namespace
 
+/*
+  Put a connection with a pending event into the queue of its class:
+  high priority, short or long.
+*/
+
+static void queue_push(thread_group_t *thread_group, connection_t *c)
+{
+  if (connection_is_high_prio(c))
+  {
+    c->tickets--;
+    thread_group->high_prio_queue.push_back(c);
+  }
+  else
+  {
+    c->tickets= c->thd->variables.threadpool_high_prio_tickets;
+    if (connection_is_long(c))
+      thread_group->long_queue.push_back(c);
+    else
+      thread_group->queue.push_back(c);
+  }
+}
+
 /* Dequeue element from a workqueue */
 
 static connection_t *queue_get(thread_group_t *thread_group)
@@ -462,18 +509,103 @@ static connection_t *queue_get(thread_group_t *thread_group)
     thread_group->high_prio_queue.remove(c);
   }
   /*
-    Don't pick events from the low priority queue if there are too many
+    Don't pick events from the low priority queues if there are too many
     active + waiting threads.
   */
-  else if (!too_many_busy_threads(thread_group) &&
-           (c= thread_group->queue.front()))
+  else if (!too_many_busy_threads(thread_group))
   {
-    thread_group->queue.remove(c);
+    /*
+      Long requests are delayed while short ones are queued, except for
+      one in every thread_pool_short_queue_weight events, so that they
+      are not starved.
+    */
+    if ((c= thread_group->long_queue.front()) &&
+        (thread_group->queue.is_empty() ||
+         thread_group->short_event_streak >= threadpool_short_queue_weight))
+    {
+      thread_group->long_queue.remove(c);
+      thread_group->short_event_streak= 0;
+    }
+    else if ((c= thread_group->queue.front()))
+    {
+      thread_group->queue.remove(c);
+      if (thread_group->long_queue.is_empty())
+        thread_group->short_event_streak= 0;
+      else
+        thread_group->short_event_streak++;
+    }
   }
   DBUG_RETURN(c);  
 }
 
 
+/**
+  Take an event from the queues of another group whose workers don't get
+  to it, moving the connection over to this group. The connection keeps
+  running in this group afterwards, so that load moves from busy groups
+  to idle ones.
+
+  Called with the mutex of thread_group locked. Other groups are only
+  try-locked, as their workers may be stealing from this one.
+*/
+
+static connection_t *steal_event(thread_group_t *thread_group)
+{
+  DBUG_ENTER("steal_event");
+  uint index= (uint) (thread_group - all_groups);
+  uint count= group_count;
+  connection_t *c= NULL;
+
+  for (uint i= 1; i < count && !c; i++)
+  {
+    thread_group_t *victim= &all_groups[(index + i) % count];
+
+    /* Peek without the lock first, most groups have nothing queued */
+    if (victim->queue.is_empty() && victim->high_prio_queue.is_empty() &&
+        victim->long_queue.is_empty())
+      continue;
+    if (mysql_mutex_trylock(&victim->mutex) != 0)
+      continue;
+
+    /*
+      Leave the events to the group itself if it has idle workers which
+      may handle them.
+    */
+    if (!victim->shutdown &&
+        (victim->waiting_threads.is_empty() ||
+         too_many_active_threads(victim)))
+    {
+      if ((c= victim->high_prio_queue.front()))
+        victim->high_prio_queue.remove(c);
+      else if ((c= victim->queue.front()))
+        victim->queue.remove(c);
+      else if ((c= victim->long_queue.front()))
+        victim->long_queue.remove(c);
+    }
+
+    if (c)
+    {
+      DBUG_ASSERT(c->thread_group == victim);
+      victim->queue_event_count++;
+      victim->connection_count--;
+      if (c->bound_to_poll_descriptor)
+      {
+        /* The event was taken from the poll descriptor, no read is armed */
+        Vio *vio= c->thd->get_protocol_classic()->get_vio();
+        io_poll_disassociate_fd(victim->pollfd,
+                                mysql_socket_getfd(vio->mysql_socket));
+        c->bound_to_poll_descriptor= false;
+      }
+      c->thread_group= thread_group;
+      thread_group->connection_count++;
+      thread_group->stolen_event_count++;
+    }
+    mysql_mutex_unlock(&victim->mutex);
+  }
+  DBUG_RETURN(c);
+}
+
+
 class Thd_timeout_checker : public Do_THD_Impl
 {
 private:
@@ -608,7 +740,8 @@ static void* timer_thread(void *param)
 static bool queues_are_empty(thread_group_t *tg)
 {
   return (tg->high_prio_queue.is_empty() &&
-          (tg->queue.is_empty() || too_many_busy_threads(tg)));
+          ((tg->queue.is_empty() && tg->long_queue.is_empty()) ||
+           too_many_busy_threads(tg)));
 }
 
 static void check_stall(thread_group_t *thread_group)
@@ -780,7 +913,7 @@ static connection_t * listener(worker_thread_t *current_thread,
     */
     
     bool listener_picks_event= thread_group->high_prio_queue.is_empty() &&
-      thread_group->queue.is_empty();
+      thread_group->queue.is_empty() && thread_group->long_queue.is_empty();
     
     /* 
       If listener_picks_event is set, listener thread will handle first event, 
@@ -790,16 +923,7 @@ static connection_t * listener(worker_thread_t *current_thread,
     for(int i=(listener_picks_event)?1:0; i < cnt ; i++)
     {
       connection_t *c= (connection_t *)native_event_get_userdata(&ev[i]);
-      if (connection_is_high_prio(c))
-      {
-        c->tickets--;
-        thread_group->high_prio_queue.push_back(c);
-      }
-      else
-      {
-        c->tickets= c->thd->variables.threadpool_high_prio_tickets;
-        thread_group->queue.push_back(c);
-      }
+      queue_push(thread_group, c);
     }
     
     if (listener_picks_event)
@@ -988,6 +1112,13 @@ static int thread_group_init(thread_group_t *thread_group,
   thread_group->pthread_attr = thread_attr;
   mysql_mutex_init(key_group_mutex, &thread_group->mutex, NULL);
   thread_group->pollfd= -1;
+  thread_group->numa_node= -1;
+#ifdef HAVE_LIBNUMA
+  /* Spread the groups over the NUMA nodes round robin */
+  if (threadpool_numa_affinity && numa_available() != -1)
+    thread_group->numa_node=
+      (int) ((thread_group - all_groups) % (numa_max_node() + 1));
+#endif
   thread_group->shutdown_pipe[0]= -1;
   thread_group->shutdown_pipe[1]= -1;
   DBUG_RETURN(0);
@@ -1188,16 +1319,16 @@ static connection_t *get_event(worker_thread_t *current_thread,
         */
         if (connection_is_high_prio(connection))
           connection->tickets--;
-        else if (too_many_busy_threads(thread_group))
+        else if (too_many_busy_threads(thread_group) ||
+                 (connection_is_long(connection) &&
+                  !thread_group->queue.is_empty()))
         {
           /*
-            Not eligible for high priority processing. Restore tickets and put
-            it into the low priority queue.
+            Not eligible for high priority processing, or a long request
+            which must not overtake queued short ones. Restore tickets and
+            put it into its low priority queue.
           */
-
-          connection->tickets=
-            connection->thd->variables.threadpool_high_prio_tickets;
-          thread_group->queue.push_back(connection);
+          queue_push(thread_group, connection);
           connection= NULL;
         }
 
@@ -1209,6 +1340,18 @@ static connection_t *get_event(worker_thread_t *current_thread,
       }
     }
 
+    /*
+      Before going to sleep, help other groups which have more events
+      than their workers handle.
+    */
+    if (!oversubscribed && threadpool_work_stealing &&
+        !too_many_busy_threads(thread_group) &&
+        (connection= steal_event(thread_group)))
+    {
+      thread_group->queue_event_count++;
+      break;
+    }
+
     /* And now, finally sleep */ 
     current_thread->woken = false; /* wake() sets this to true */
 
@@ -1319,6 +1462,7 @@ static connection_t *alloc_connection(THD *thd)
     connection->bound_to_poll_descriptor= false;
     connection->abs_wait_timeout= ULLONG_MAX;
     connection->tickets = 0;
+    connection->avg_request_time= 0;
   }
   DBUG_RETURN(connection);
 }
@@ -1538,19 +1682,18 @@ static int start_io(connection_t *connection)
 
   /*
     Usually, connection will stay in the same group for the entire
-    connection's life. However, we do allow group_count to
-    change at runtime, which means in rare cases when it changes is 
-    connection should need to migrate  to another group, this ensures
-    to ensure equal load between groups.
-
-    So we recalculate in which group the connection should be, based
-    on thread_id and current group count, and migrate if necessary.
+    connection's life, unless it is moved by work stealing (see
+    steal_event()). However, we do allow group_count to change at
+    runtime, so a connection whose group has been removed migrates to
+    another group, based on thread_id and the current group count.
+    Groups which are added get their share of the load from the new
+    connections and by stealing events.
   */ 
-  thread_group_t *group = 
-    &all_groups[connection->thd->thread_id() % group_count];
+  thread_group_t *group= connection->thread_group;
 
-  if (group != connection->thread_group)
+  if ((uint) (group - all_groups) >= group_count)
   {
+    group= &all_groups[connection->thd->thread_id() % group_count];
     if (change_group(connection, connection->thread_group, group))
       return -1;
   }
@@ -1580,7 +1723,12 @@ static void handle_event(connection_t *connection)
   }
   else
   {
+    ulonglong start_time= my_micro_time();
     err= threadpool_process_request(connection->thd);
+    /* Average over the last few requests, new ones weigh 1/4 */
+    ulonglong request_time= my_micro_time() - start_time;
+    connection->avg_request_time=
+      (3 * connection->avg_request_time + request_time) / 4;
   }
 
   if(err)
@@ -1617,6 +1765,11 @@ static void *worker_main(void *param)
   this_thread.thread_group= thread_group;
   this_thread.event_count=0;
 
+#ifdef HAVE_LIBNUMA
+  if (thread_group->numa_node >= 0)
+    numa_run_on_node(thread_group->numa_node);
+#endif
+
 #ifdef HAVE_PSI_THREAD_INTERFACE
     PSI_THREAD_CALL(set_thread_account)
       (NULL, 0, NULL, 0);
@@ -1741,6 +1894,29 @@ void tp_set_threadpool_stall_limit(uint limit)
 }
 
 
+/** Get the state of a thread group, false if there is no such group. */
+bool tp_get_group_stats(uint group_id, TP_GROUP_STATS *stats)
+{
+  if (!threadpool_started || group_id >= group_count)
+    return false;
+
+  thread_group_t *group= &all_groups[group_id];
+  mysql_mutex_lock(&group->mutex);
+  stats->connection_count= group->connection_count;
+  stats->thread_count= group->thread_count;
+  stats->active_thread_count= group->active_thread_count;
+  stats->waiting_thread_count= group->waiting_thread_count;
+  stats->queue_length= group->queue.elements();
+  stats->high_prio_queue_length= group->high_prio_queue.elements();
+  stats->long_queue_length= group->long_queue.elements();
+  stats->stolen_event_count= group->stolen_event_count;
+  stats->numa_node= group->numa_node;
+  stats->stalled= group->stalled;
+  mysql_mutex_unlock(&group->mutex);
+  return true;
+}
+
+
 /**
  Calculate number of idle/waiting threads in the pool.
  
@@ -368,6 +368,9 @@ bool Unique::flush()
 		(void*) this, left_root_right) ||
       file_ptrs.push_back(file_ptr))
     return 1;
+  const ulonglong bytes= my_b_tell(&file) - file_ptr.file_position();
+  current_thd->sort_spill_bytes+= bytes;
+  current_thd->sort_spill_disk_bytes+= bytes;
   delete_tree(&tree);
   return 0;
 }
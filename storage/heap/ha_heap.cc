@@ -882,6 +882,13 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->auto_key= auto_key;
   hp_create_info->auto_key_type= auto_key_type;
   hp_create_info->max_table_size=current_thd->variables.max_heap_table_size;
+  /*
+    The number of rows of internal tmp tables with dynamic rows is not
+    limited by the server, so apply tmp_table_size to their memory.
+  */
+  if (internal_table && share->row_type == ROW_TYPE_DYNAMIC)
+    set_if_smaller(hp_create_info->max_table_size,
+                   current_thd->variables.tmp_table_size);
   hp_create_info->with_auto_increment= found_real_auto_increment;
   hp_create_info->internal_table= internal_table;
   hp_create_info->max_chunk_size= share->key_block_size;
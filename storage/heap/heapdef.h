@@ -62,7 +62,8 @@ if (!(info->update & HA_STATE_AKTIV))\
    (info)->chunk_dataspace_length)
 
 #define is_blob_column(c) \
-  ((c)->type == MYSQL_TYPE_BLOB || (c)->type == MYSQL_TYPE_JSON)
+  ((c)->type == MYSQL_TYPE_BLOB || (c)->type == MYSQL_TYPE_JSON || \
+   (c)->type == MYSQL_TYPE_GEOMETRY)
 
 typedef struct st_hp_hash_info
 {
@@ -529,6 +529,7 @@ dict_stats_empty_index(
 
 	index->stat_index_size = 1;
 	index->stat_n_leaf_pages = 1;
+	index->stat_modified_counter = 0;
 }
 
 /*********************************************************************//**
@@ -2176,19 +2177,32 @@ found_level:
 Calculates new estimates for table and index statistics. This function
 is relatively slow and is used to calculate persistent statistics that
 will be saved on disk.
+If only_stale is true, then only the indexes for which
+dict_stats_index_is_stale() holds are analyzed and the current estimates
+of the other indexes are kept. This is used by the background statistics
+thread if innodb_stats_incremental_recalc is enabled.
 @return DB_SUCCESS or error code */
 static
 dberr_t
 dict_stats_update_persistent(
 /*=========================*/
-	dict_table_t*	table)		/*!< in/out: table */
+	dict_table_t*	table,		/*!< in/out: table */
+	bool		only_stale)	/*!< in: analyze only the indexes
+					whose statistics are stale */
 {
 	dict_index_t*	index;
+	ib_uint64_t	n_rows;
 
 	DEBUG_PRINTF("%s(table=%s)\n", __func__, table->name);
 
 	dict_table_stats_lock(table, RW_X_LATCH);
 
+	/* Incremental recalculation is only possible if there are
+	estimates to keep for the indexes that are not stale */
+	only_stale = only_stale && table->stat_initialized;
+
+	n_rows = table->stat_n_rows;
+
 	/* analyze the clustered index first */
 
 	index = dict_table_get_first_index(table);
@@ -2206,13 +2220,16 @@ dict_stats_update_persistent(
 
 	ut_ad(!dict_index_is_ibuf(index));
 
-	dict_stats_analyze_index(index);
+	if (!only_stale || dict_stats_index_is_stale(index, n_rows)) {
 
-	ulint	n_unique = dict_index_get_n_unique(index);
+		dict_stats_analyze_index(index);
 
-	table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
+		ulint	n_unique = dict_index_get_n_unique(index);
 
-	table->stat_clustered_index_size = index->stat_index_size;
+		table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
+
+		table->stat_clustered_index_size = index->stat_index_size;
+	}
 
 	/* analyze other indexes from the table, if any */
 
@@ -2228,6 +2245,16 @@ dict_stats_update_persistent(
 			continue;
 		}
 
+		if (only_stale
+		    && !dict_stats_should_ignore_index(index)
+		    && !dict_stats_index_is_stale(index, n_rows)) {
+
+			/* Keep the current estimates of this index */
+			table->stat_sum_of_other_index_sizes
+				+= index->stat_index_size;
+			continue;
+		}
+
 		dict_stats_empty_index(index);
 
 		if (dict_stats_should_ignore_index(index)) {
@@ -3079,6 +3106,7 @@ dict_stats_update(
 
 	switch (stats_upd_option) {
 	case DICT_STATS_RECALC_PERSISTENT:
+	case DICT_STATS_RECALC_PERSISTENT_STALE:
 
 		if (srv_read_only_mode) {
 			goto transient;
@@ -3088,7 +3116,8 @@ dict_stats_update(
 		1) ANALYZE TABLE, or
 		2) the auto recalculation background thread, or
 		3) open table if stats do not exist on disk and auto recalc
-		   is enabled */
+		   is enabled
+		DICT_STATS_RECALC_PERSISTENT_STALE is only used by 2) */
 
 		/* InnoDB internal tables (e.g. SYS_TABLES) cannot have
 		persistent stats enabled */
@@ -3102,7 +3131,10 @@ dict_stats_update(
 
 			dberr_t	err;
 
-			err = dict_stats_update_persistent(table);
+			err = dict_stats_update_persistent(
+				table,
+				stats_upd_option
+				== DICT_STATS_RECALC_PERSISTENT_STALE);
 
 			if (err != DB_SUCCESS) {
 				return(err);
@@ -184,7 +184,7 @@ dict_stats_recalc_pool_del() */
 void
 dict_stats_recalc_pool_del(
 /*=======================*/
-	const dict_table_t*	table)	/*!< in: table to remove */
+	dict_table_t*	table)	/*!< in/out: table to remove */
 {
 	ut_ad(!srv_read_only_mode);
 	ut_ad(mutex_own(&dict_sys->mutex));
@@ -204,6 +204,8 @@ dict_stats_recalc_pool_del(
 		}
 	}
 
+	table->stats_recalc_queued = false;
+
 	mutex_exit(&recalc_pool_mutex);
 }
 
@@ -319,6 +321,7 @@ dict_stats_process_entry_from_recalc_pool()
 	}
 
 	if (fil_space_is_being_truncated(table->space)) {
+		table->stats_recalc_queued = false;
 		dict_table_close(table, TRUE, FALSE);
 		mutex_exit(&dict_sys->mutex);
 		return;
@@ -326,6 +329,7 @@ dict_stats_process_entry_from_recalc_pool()
 
 	/* Check whether table is corrupted */
 	if (table->corrupted) {
+		table->stats_recalc_queued = false;
 		dict_table_close(table, TRUE, FALSE);
 		mutex_exit(&dict_sys->mutex);
 		return;
@@ -335,6 +339,8 @@ dict_stats_process_entry_from_recalc_pool()
 
 	mutex_exit(&dict_sys->mutex);
 
+	bool	requeued = false;
+
 	/* ut_time() could be expensive, the current function
 	is called once every time a table has been changed more than 10% and
 	on a system with lots of small tables, this could become hot. If we
@@ -350,6 +356,13 @@ dict_stats_process_entry_from_recalc_pool()
 		the auto recalc list and do nothing. */
 
 		dict_stats_recalc_pool_add(table);
+		requeued = true;
+
+	} else if (srv_stats_incremental_recalc) {
+
+		/* Only re-analyze the indexes that have changed too
+		much, see row_update_statistics_if_needed() */
+		dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT_STALE);
 
 	} else {
 
@@ -360,6 +373,12 @@ dict_stats_process_entry_from_recalc_pool()
 
 	table->stats_bg_flag = BG_STAT_NONE;
 
+	if (!requeued) {
+		/* The stale indexes have been re-analyzed, the table can
+		be enqueued again, see row_update_statistics_if_needed() */
+		table->stats_recalc_queued = false;
+	}
+
 	dict_table_close(table, TRUE, FALSE);
 
 	mutex_exit(&dict_sys->mutex);
@@ -46,6 +46,7 @@ Created 10/25/1995 Heikki Tuuri
 # include "buf0lru.h"
 # include "ibuf0ibuf.h"
 # include "os0event.h"
+# include "srv0mon.h"
 # include "sync0sync.h"
 #endif /* !UNIV_HOTBACKUP */
 #include "buf0flu.h"
@@ -193,6 +194,10 @@ struct fil_system_t {
 					space id's of the tables there */
 	UT_LIST_BASE_NODE_T(fil_space_t) space_list;
 					/*!< list of all file spaces */
+	UT_LIST_BASE_NODE_T(fil_space_t) prealloc_spaces;
+					/*!< list of tablespaces whose data
+					files the tablespace preallocation
+					thread should extend */
 	UT_LIST_BASE_NODE_T(fil_space_t) named_spaces;
 					/*!< list of all file spaces
 					for which a MLOG_FILE_NAME
@@ -209,6 +214,32 @@ struct fil_system_t {
 initialized. */
 static fil_system_t*	fil_system	= NULL;
 
+#ifndef UNIV_HOTBACKUP
+/** Number of slots in fil_io_fast_slots */
+static const ulint	FIL_IO_FAST_N_SLOTS = 4096;
+
+/** A slot of the lookup table of the lock-free fast path of fil_io().
+An open file of a single-file user tablespace is published in the slot of
+its space id by fil_node_prepare_for_io(), so that subsequent reads from it
+can find and pin the file node without acquiring fil_system->mutex.
+The node member is modified only while holding fil_system->mutex. */
+struct fil_io_fast_slot_t {
+	/** the published file node, or NULL */
+	fil_node_t* volatile	node;
+	/** number of threads that have pinned the slot; as long as this
+	is nonzero, the file node in the slot, or the file node that was
+	just removed from it, may have pending i/o's */
+	volatile ulint		n_pins;
+	/** padding to prevent false sharing between the slots */
+	byte			pad[CACHE_LINE_SIZE
+				    - sizeof(fil_node_t*) - sizeof(ulint)];
+};
+
+/** The lookup table of the lock-free fast path of fil_io(), hashed on the
+space id; FIL_IO_FAST_N_SLOTS elements */
+static fil_io_fast_slot_t*	fil_io_fast_slots	= NULL;
+#endif /* !UNIV_HOTBACKUP */
+
 #ifdef UNIV_HOTBACKUP
 static ulint	srv_data_read;
 static ulint	srv_data_written;
@@ -289,6 +320,139 @@ fil_space_belongs_in_lru(
 	return(false);
 }
 
+#ifndef UNIV_HOTBACKUP
+/** Get the slot of a tablespace in the fast path lookup table.
+@param[in]	space_id	tablespace id
+@return the slot */
+UNIV_INLINE
+fil_io_fast_slot_t*
+fil_io_fast_slot_get(
+	ulint	space_id)
+{
+	return(&fil_io_fast_slots[space_id % FIL_IO_FAST_N_SLOTS]);
+}
+
+/** Publish an open file node for the fast path of fil_io(), if the
+tablespace qualifies and the slot is free. Only single-file user
+tablespaces which are not being renamed, deleted or truncated are
+published. The caller must hold fil_system->mutex.
+@param[in]	node	open file node */
+static
+void
+fil_node_publish_for_fast_io(
+	fil_node_t*	node)
+{
+	ut_ad(mutex_own(&fil_system->mutex));
+
+	const fil_space_t*	space = node->space;
+
+	if (!node->is_open
+	    || node->size == 0
+	    || space->purpose != FIL_TYPE_TABLESPACE
+	    || !fil_space_belongs_in_lru(space)
+	    || UT_LIST_GET_LEN(space->chain) != 1
+	    || space->stop_ios
+	    || space->stop_new_ops
+	    || space->is_being_truncated
+	    || space->is_corrupt) {
+		return;
+	}
+
+	fil_io_fast_slot_t*	slot = fil_io_fast_slot_get(space->id);
+
+	if (slot->node == NULL) {
+		/* Make the node visible only after its fields */
+		os_wmb;
+		slot->node = node;
+	}
+}
+
+/** Remove a file node from the fast path of fil_io(), so that no new
+i/o's can pin it. The node stays unpublished until the next i/o on the
+slow path publishes it again. The caller must hold fil_system->mutex.
+@param[in,out]	node	file node
+@return true if the node has no pending fast path i/o's */
+static
+bool
+fil_node_unpublish_for_fast_io(
+	fil_node_t*	node)
+{
+	ut_ad(mutex_own(&fil_system->mutex));
+
+	fil_io_fast_slot_t*	slot = fil_io_fast_slot_get(node->space->id);
+
+	if (slot->node != node) {
+		return(true);
+	}
+
+	slot->node = NULL;
+
+	/* The atomic read-modify-write below is a full memory barrier:
+	any thread that pins the slot after it will see the slot empty,
+	see fil_node_pin_for_fast_io() */
+
+	return(os_atomic_increment_ulint(&slot->n_pins, 0) == 0);
+}
+
+/** Try to pin the file node containing a page for a read on the fast path
+of fil_io(), without acquiring fil_system->mutex. A pinned node stays open
+until it is unpinned by fil_node_unpin_for_fast_io().
+@param[in]	page_id	page to read
+@return pinned file node, or NULL if the slow path must be used */
+static
+fil_node_t*
+fil_node_pin_for_fast_io(
+	const page_id_t&	page_id)
+{
+	fil_io_fast_slot_t*	slot = fil_io_fast_slot_get(page_id.space());
+
+	os_atomic_increment_ulint(&slot->n_pins, 1);
+
+	fil_node_t*	node = slot->node;
+
+	if (node != NULL) {
+		const fil_space_t*	space = node->space;
+
+		if (space->id == page_id.space()
+		    && page_id.page_no() < node->size
+		    && !space->stop_ios
+		    && !space->stop_new_ops
+		    && !space->is_being_truncated
+		    && !space->is_corrupt) {
+
+			ut_ad(node->is_open);
+
+			/* Let fil_try_to_close_file_in_LRU() know that the
+			file is in use. Avoid writing the cache line when the
+			flag is already set. */
+			if (!node->fast_io_accessed) {
+				node->fast_io_accessed = true;
+			}
+
+			return(node);
+		}
+	}
+
+	os_atomic_decrement_ulint(&slot->n_pins, 1);
+
+	return(NULL);
+}
+
+/** Unpin a file node that was pinned by fil_node_pin_for_fast_io().
+@param[in]	node	pinned file node */
+UNIV_INLINE
+void
+fil_node_unpin_for_fast_io(
+	const fil_node_t*	node)
+{
+	fil_io_fast_slot_t*	slot = fil_io_fast_slot_get(node->space->id);
+
+	ut_ad(slot->n_pins > 0);
+
+	os_atomic_decrement_ulint(&slot->n_pins, 1);
+}
+#endif /* !UNIV_HOTBACKUP */
+
 /********************************************************************//**
 NOTE: you must call fil_mutex_enter_and_prepare_for_io() first!
 
@@ -930,6 +1094,18 @@ fil_node_close_file(
 
 	ut_ad(mutex_own(&(fil_system->mutex)));
 	ut_a(node->is_open);
+#ifndef UNIV_HOTBACKUP
+	/* Wait for the pending fast path i/o's without holding
+	fil_system->mutex, so that the i/o's on the other tablespaces are not
+	blocked meanwhile. The callers make sure that no new i/o's start on
+	the file: they have already waited for the fast path i/o's, or the
+	server is shutting down. */
+	while (!fil_node_unpublish_for_fast_io(node)) {
+		mutex_exit(&fil_system->mutex);
+		os_thread_sleep(100);
+		mutex_enter(&fil_system->mutex);
+	}
+#endif /* !UNIV_HOTBACKUP */
 	ut_a(node->n_pending == 0);
 	ut_a(node->n_pending_flushes == 0);
 	ut_a(!node->being_extended);
@@ -982,13 +1158,35 @@ fil_try_to_close_file_in_LRU(
 			<< UT_LIST_GET_LEN(fil_system->LRU);
 	}
 
+	/* Reads on the fast path of fil_io() do not move the nodes in the
+	LRU list: give the nodes that were read since they were last seen
+	here a second chance, by moving them to the start of the list, where
+	the scan reaches them last. The number of moves is bounded, so that
+	the scan ends even if the nodes keep being read. */
+	ulint		n_moves = UT_LIST_GET_LEN(fil_system->LRU);
+	fil_node_t*	prev;
+
 	for (node = UT_LIST_GET_LAST(fil_system->LRU);
 	     node != NULL;
-	     node = UT_LIST_GET_PREV(LRU, node)) {
+	     node = prev) {
+
+		prev = UT_LIST_GET_PREV(LRU, node);
+
+		if (node->fast_io_accessed && n_moves > 0) {
+			node->fast_io_accessed = false;
+			n_moves--;
+
+			if (prev != NULL) {
+				UT_LIST_REMOVE(fil_system->LRU, node);
+				UT_LIST_ADD_FIRST(fil_system->LRU, node);
+				continue;
+			}
+		}
 
 		if (node->modification_counter == node->flush_counter
 		    && node->n_pending_flushes == 0
-		    && !node->being_extended) {
+		    && !node->being_extended
+		    && fil_node_unpublish_for_fast_io(node)) {
 
 			fil_node_close_file(node);
 
@@ -1216,6 +1414,13 @@ fil_space_detach(
 		UT_LIST_REMOVE(fil_system->unflushed_spaces, space);
 	}
 
+	if (space->is_in_prealloc_spaces) {
+
+		space->is_in_prealloc_spaces = false;
+
+		UT_LIST_REMOVE(fil_system->prealloc_spaces, space);
+	}
+
 	UT_LIST_REMOVE(fil_system->space_list, space);
 
 	ut_a(space->magic_n == FIL_SPACE_MAGIC_N);
@@ -1741,11 +1946,19 @@ fil_init(
 	fil_system->spaces = hash_create(hash_size);
 	fil_system->name_hash = hash_create(hash_size);
 
+#ifndef UNIV_HOTBACKUP
+	fil_io_fast_slots = static_cast<fil_io_fast_slot_t*>(
+		ut_zalloc_nokey(FIL_IO_FAST_N_SLOTS
+				* sizeof(*fil_io_fast_slots)));
+#endif /* !UNIV_HOTBACKUP */
+
 	UT_LIST_INIT(fil_system->LRU, &fil_node_t::LRU);
 	UT_LIST_INIT(fil_system->space_list, &fil_space_t::space_list);
 	UT_LIST_INIT(fil_system->unflushed_spaces,
 		     &fil_space_t::unflushed_spaces);
 	UT_LIST_INIT(fil_system->named_spaces, &fil_space_t::named_spaces);
+	UT_LIST_INIT(fil_system->prealloc_spaces,
+		     &fil_space_t::prealloc_spaces);
 
 	fil_system->max_n_open = max_n_open;
 }
@@ -2602,7 +2815,8 @@ fil_check_pending_io(
 
 	*node = UT_LIST_GET_FIRST(space->chain);
 
-	if (space->n_pending_flushes > 0 || (*node)->n_pending > 0) {
+	if (space->n_pending_flushes > 0 || (*node)->n_pending > 0
+	    || !fil_node_unpublish_for_fast_io(*node)) {
 
 		ut_a(!(*node)->being_extended);
 
@@ -3399,7 +3613,8 @@ func_exit:
 
 	if (node->n_pending > 0
 	    || node->n_pending_flushes > 0
-	    || node->being_extended) {
+	    || node->being_extended
+	    || !fil_node_unpublish_for_fast_io(node)) {
 		/* There are pending i/o's or flushes or the file is
 		currently being extended, sleep for a while and
 		retry */
@@ -5187,6 +5402,136 @@ retry:
 	return(success);
 }
 
+#ifndef UNIV_HOTBACKUP
+/** Ask the tablespace preallocation thread to extend the data file of a
+tablespace ahead of the size stored in its header, up to
+innodb_tablespace_prealloc_extents free extents.
+@param[in,out]	space	single-table or general tablespace */
+void
+fil_space_request_prealloc(
+	fil_space_t*	space)
+{
+	ut_ad(!srv_read_only_mode);
+	ut_ad(!is_system_tablespace(space->id));
+
+	mutex_enter(&fil_system->mutex);
+
+	if (!space->is_in_prealloc_spaces) {
+
+		space->is_in_prealloc_spaces = true;
+
+		UT_LIST_ADD_LAST(fil_system->prealloc_spaces, space);
+	}
+
+	mutex_exit(&fil_system->mutex);
+
+	os_event_set(srv_fil_prealloc_event);
+}
+
+/** Extend the data file of a tablespace so that it has
+innodb_tablespace_prealloc_extents free extents beyond the size stored
+in the tablespace header. The file is extended in steps of FSP_FREE_ADD
+extents, so that a thread that needs to extend the file itself does not
+have to wait long for fil_space_extend() to finish here.
+@param[in,out]	space	tablespace, acquired with fil_space_acquire() */
+static
+void
+fil_space_prealloc(
+	fil_space_t*	space)
+{
+	const ulint	extent_pages = fsp_get_extent_size_in_pages(
+		page_size_t(space->flags));
+
+	/* The size fields are read without holding the tablespace latch or
+	fil_system->mutex. If they are stale, we only preallocate slightly
+	more or less than requested: fil_space_extend() will check the
+	actual size of the file again. */
+	os_rmb;
+	const ulint	target = space->size_in_header
+		+ srv_tablespace_prealloc_extents * extent_pages;
+
+	while (srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+
+		const ulint	size = space->size;
+
+		if (size >= target) {
+			break;
+		}
+
+		if (!fil_space_extend(
+			    space,
+			    ut_min(target, size + FSP_FREE_ADD * extent_pages))) {
+			break;
+		}
+
+		MONITOR_INC_VALUE(MONITOR_TABLESPACE_PREALLOC_PAGES,
+				  space->size - size);
+	}
+}
+
+/** This is the tablespace preallocation thread. It waits for requests
+made by fil_space_request_prealloc() and extends the data files of the
+requested tablespaces, so that the threads inserting into them seldom
+need to extend the files themselves while holding the tablespace latch.
+@param[in]	arg	a dummy parameter required by os_thread_create.
+@return	this function does not return, calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(fil_prealloc_thread)(
+	void*	arg MY_ATTRIBUTE((unused)))
+{
+	my_thread_init();
+	ut_ad(!srv_read_only_mode);
+
+	srv_fil_prealloc_thread_active = true;
+
+	while (srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+
+		os_event_wait(srv_fil_prealloc_event);
+		os_event_reset(srv_fil_prealloc_event);
+
+		while (srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+
+			mutex_enter(&fil_system->mutex);
+
+			fil_space_t*	space = UT_LIST_GET_FIRST(
+				fil_system->prealloc_spaces);
+
+			if (space == NULL) {
+				mutex_exit(&fil_system->mutex);
+				break;
+			}
+
+			ut_ad(space->is_in_prealloc_spaces);
+			space->is_in_prealloc_spaces = false;
+			UT_LIST_REMOVE(fil_system->prealloc_spaces, space);
+
+			const ulint	space_id = space->id;
+
+			mutex_exit(&fil_system->mutex);
+
+			/* Prevent the tablespace from being dropped or
+			truncated while we are extending it. */
+			space = fil_space_acquire_silent(space_id);
+
+			if (space != NULL) {
+				fil_space_prealloc(space);
+				fil_space_release(space);
+			}
+		}
+	}
+
+	srv_fil_prealloc_thread_active = false;
+
+	my_thread_end();
+	/* We count the number of threads in os_thread_exit(). A created
+	thread should always use that to exit and not use return() to exit. */
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+#endif /* !UNIV_HOTBACKUP */
+
 #ifdef UNIV_HOTBACKUP
 /********************************************************************//**
 Extends all tablespaces to the size stored in the space header. During the
@@ -5375,9 +5720,43 @@ fil_node_prepare_for_io(
 
 	node->n_pending++;
 
+#ifndef UNIV_HOTBACKUP
+	/* Let the subsequent reads from the file bypass fil_system->mutex */
+	fil_node_publish_for_fast_io(node);
+#endif /* !UNIV_HOTBACKUP */
+
 	return(true);
 }
 
+#ifndef UNIV_HOTBACKUP
+/** Updates the data structures when an i/o operation started by fil_io()
+finishes. If the i/o was done on the fast path, the file node is just
+unpinned, otherwise fil_node_complete_io() is called.
+@param[in,out]	node	file node
+@param[in]	type	IO context */
+static
+void
+fil_io_complete(
+	fil_node_t*		node,
+	const IORequest&	type)
+{
+	if (type.is_fil_node_pinned()) {
+
+		ut_ad(type.is_read());
+
+		fil_node_unpin_for_fast_io(node);
+
+		return;
+	}
+
+	mutex_enter(&fil_system->mutex);
+
+	fil_node_complete_io(node, fil_system, type);
+
+	mutex_exit(&fil_system->mutex);
+}
+#endif /* !UNIV_HOTBACKUP */
+
 /********************************************************************//**
 Updates the data structures when an i/o operation finishes. Updates the
 pending i/o's field in the node appropriately. */
@@ -5592,12 +5971,32 @@ _fil_io(
 	}
 #endif /* !UNIV_HOTBACKUP */
 
+	fil_space_t*	space;
+	fil_node_t*	node;
+	ulint		cur_page_no = page_id.page_no();
+
+#ifndef UNIV_HOTBACKUP
+	/* Reads from an open file of a single-file tablespace do not
+	need to change the data structures of fil_system: pin the file
+	node without acquiring the fil_system mutex if possible */
+
+	if (req_type.is_read()
+	    && (node = fil_node_pin_for_fast_io(page_id)) != NULL) {
+
+		space = node->space;
+
+		req_type.set_fil_node_pinned();
+
+		goto do_io;
+	}
+#endif /* !UNIV_HOTBACKUP */
+
 	/* Reserve the fil_system mutex and make sure that we can open at
 	least one file while holding it, if the file is not already open */
 
 	fil_mutex_enter_and_prepare_for_io(page_id.space());
 
-	fil_space_t*	space = fil_space_get_by_id(page_id.space());
+	space = fil_space_get_by_id(page_id.space());
 
 	/* If we are deleting a tablespace we don't allow async read operations
 	on that. However, we do allow write operations and sync read operations. */
@@ -5623,8 +6022,7 @@ _fil_io(
 
 	ut_ad(mode != OS_AIO_IBUF || fil_type_is_data(space->purpose));
 
-	ulint		cur_page_no = page_id.page_no();
-	fil_node_t*	node = UT_LIST_GET_FIRST(space->chain);
+	node = UT_LIST_GET_FIRST(space->chain);
 
 	for (;;) {
 
@@ -5724,6 +6122,9 @@ _fil_io(
 	/* Now we have made the changes in the data structures of fil_system */
 	mutex_exit(&fil_system->mutex);
 
+#ifndef UNIV_HOTBACKUP
+do_io:
+#endif /* !UNIV_HOTBACKUP */
 	/* Calculate the low 32 bits and the high 32 bits of the file offset */
 
 	if (!page_size.is_compressed()) {
@@ -5767,9 +6168,7 @@ _fil_io(
 		/* should ignore i/o for the crashed space */
 		if (srv_pass_corrupt_table == 1 || req_type.is_write()) {
 
-			mutex_enter(&fil_system->mutex);
-			fil_node_complete_io(node, fil_system, type);
-			mutex_exit(&fil_system->mutex);
+			fil_io_complete(node, req_type);
 			if (mode == OS_AIO_NORMAL) {
 				ut_a(space->purpose == FIL_TYPE_TABLESPACE);
 				buf_page_io_complete(static_cast<buf_page_t *>
@@ -5864,11 +6263,15 @@ _fil_io(
 		/* The i/o operation is already completed when we return from
 		os_aio: */
 
+#ifndef UNIV_HOTBACKUP
+		fil_io_complete(node, req_type);
+#else /* !UNIV_HOTBACKUP */
 		mutex_enter(&fil_system->mutex);
 
 		fil_node_complete_io(node, fil_system, req_type);
 
 		mutex_exit(&fil_system->mutex);
+#endif /* !UNIV_HOTBACKUP */
 
 		ut_ad(fil_validate_skip());
 	}
@@ -5905,11 +6308,7 @@ fil_aio_wait(
 
 	srv_set_io_thread_op_info(segment, "complete io for fil node");
 
-	mutex_enter(&fil_system->mutex);
-
-	fil_node_complete_io(node, fil_system, type);
-
-	mutex_exit(&fil_system->mutex);
+	fil_io_complete(node, type);
 
 	ut_ad(fil_validate_skip());
 
@@ -6309,6 +6708,11 @@ fil_close(void)
 	ut_a(UT_LIST_GET_LEN(fil_system->unflushed_spaces) == 0);
 	ut_a(UT_LIST_GET_LEN(fil_system->space_list) == 0);
 
+#ifndef UNIV_HOTBACKUP
+	ut_free(fil_io_fast_slots);
+	fil_io_fast_slots = NULL;
+#endif /* !UNIV_HOTBACKUP */
+
 	mutex_free(&fil_system->mutex);
 
 	ut_free(fil_system);
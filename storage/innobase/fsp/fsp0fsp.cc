@@ -50,6 +50,7 @@ Created 11/29/1995 Heikki Tuuri
 #include "fsp0sysspace.h"
 #include "dict0mem.h"
 #include "fsp0types.h"
+#include "srv0mon.h"
 
 #include <my_aes.h>
 
@@ -1406,6 +1407,61 @@ fsp_header_get_tablespace_size(void)
 	return(size);
 }
 
+/** Extend the data file of a tablespace on behalf of a thread that holds
+the tablespace latch. Unless the file was already preallocated far enough
+by the tablespace preallocation thread, the time spent is reported as a
+stall in INNODB_METRICS.
+@param[in,out]	space	tablespace
+@param[in]	size	desired size in pages
+@return whether the tablespace is at least as big as requested */
+static
+bool
+fsp_space_extend(
+	fil_space_t*	space,
+	ulint		size)
+{
+	if (space->size >= size) {
+		/* No need to wait for the extension of the file */
+		return(fil_space_extend(space, size));
+	}
+
+	uintmax_t	start_us = ut_time_us(NULL);
+
+	bool		success = fil_space_extend(space, size);
+
+	MONITOR_INC(MONITOR_TABLESPACE_EXTEND_STALLS);
+	MONITOR_INC_VALUE(MONITOR_TABLESPACE_EXTEND_STALL_TIME,
+			  ut_time_us(NULL) - start_us);
+
+	return(success);
+}
+
+/** Ask the tablespace preallocation thread to extend the data file of a
+tablespace if less than half of innodb_tablespace_prealloc_extents free
+extents are left in it beyond the size stored in the tablespace header.
+The system, undo and temporary tablespaces are not preallocated.
+@param[in,out]	space	tablespace whose size was just increased */
+static
+void
+fsp_space_prealloc_if_needed(
+	fil_space_t*	space)
+{
+	if (srv_tablespace_prealloc_extents == 0
+	    || srv_read_only_mode
+	    || space->purpose != FIL_TYPE_TABLESPACE
+	    || is_system_or_undo_tablespace(space->id)
+	    || fsp_is_system_temporary(space->id)) {
+		return;
+	}
+
+	const ulint	low_water = srv_tablespace_prealloc_extents
+		* fsp_get_extent_size_in_pages(page_size_t(space->flags)) / 2;
+
+	if (space->size < space->size_in_header + low_water) {
+		fil_space_request_prealloc(space);
+	}
+}
+
 /** Try to extend a single-table tablespace so that a page would fit in the
 data file.
 @param[in,out]	space	tablespace
@@ -1432,10 +1488,17 @@ fsp_try_extend_data_file_with_pages(
 
 	ut_a(page_no >= size);
 
-	success = fil_space_extend(space, page_no + 1);
-	/* The size may be less than we wanted if we ran out of disk space. */
-	mlog_write_ulint(header + FSP_SIZE, space->size, MLOG_4BYTES, mtr);
-	space->size_in_header = space->size;
+	success = fsp_space_extend(space, page_no + 1);
+	/* The size may be less than we wanted if we ran out of disk space,
+	or more if the file was preallocated in the background: take only
+	the requested amount of it into use. This is never the system
+	tablespace, see the assertion above. */
+	size = ut_min(space->size, page_no + 1);
+
+	mlog_write_ulint(header + FSP_SIZE, size, MLOG_4BYTES, mtr);
+	space->size_in_header = size;
+
+	fsp_space_prealloc_if_needed(space);
 
 	return(success);
 }
@@ -1525,19 +1588,31 @@ fsp_try_extend_data_file(
 		return(false);
 	}
 
-	if (!fil_space_extend(space, size + size_increase)) {
+	if (!fsp_space_extend(space, size + size_increase)) {
 		return(false);
 	}
 
+	/* If the data file was preallocated in the background, take only
+	the requested amount of it into use, so that the rest remains
+	available for the next extensions. */
+
+	ulint	new_size = space->size;
+
+	if (!is_system_tablespace(space->id)) {
+		new_size = ut_min(new_size, size + size_increase);
+	}
+
 	/* We ignore any fragments of a full megabyte when storing the size
 	to the space header */
 
 	space->size_in_header = ut_calc_align_down(
-		space->size, (1024 * 1024) / page_size.physical());
+		new_size, (1024 * 1024) / page_size.physical());
 
 	mlog_write_ulint(
 		header + FSP_SIZE, space->size_in_header, MLOG_4BYTES, mtr);
 
+	fsp_space_prealloc_if_needed(space);
+
 	return(true);
 }
 
@@ -4216,12 +4216,19 @@ fts_query_free_result(
 	}
 }
 
-/*****************************************************************//**
-FTS Query sort result, returned by fts_query() on fts_ranking_t::rank. */
+/** FTS Query sort result, returned by fts_query() on fts_ranking_t::rank.
+When the caller only reads the first limit documents, as for
+ORDER BY MATCH() ... LIMIT, only the highest ranked limit documents are
+kept in result->rankings_by_rank. This is a top-k selection in
+O(n log k) instead of sorting the whole result; the rest is sorted by
+fts_query_next_result_on_rank() only if it is needed after all.
+@param[in,out]	result	result instance to sort
+@param[in]	limit	number of the highest ranked documents that the
+caller is going to read, or ULINT_UNDEFINED to sort all of them */
 void
 fts_query_sort_result_on_rank(
-/*==========================*/
-	fts_result_t*	result)		/*!< out: result instance to sort.*/
+	fts_result_t*	result,
+	ulint		limit)
 {
 	const ib_rbt_node_t*	node;
 	ib_rbt_t*		ranked;
@@ -4233,6 +4240,8 @@ fts_query_sort_result_on_rank(
 
 	ranked = rbt_create(sizeof(fts_ranking_t), fts_query_compare_rank);
 
+	result->rankings_truncated = false;
+
 	/* We need to free any instances of fts_doc_freq_t that we
 	may have allocated. */
 	for (node = rbt_first(result->rankings_by_id);
@@ -4245,6 +4254,24 @@ fts_query_sort_result_on_rank(
 
 		ut_a(ranking->words == NULL);
 
+		if (rbt_size(ranked) >= limit) {
+			const ib_rbt_node_t*	last = rbt_last(ranked);
+
+			result->rankings_truncated = true;
+
+			/* Documents of equal rank are ordered by insertion,
+			so a document ranked equal to the last one is not
+			among the first limit documents either. */
+			if (last == NULL
+			    || fts_query_compare_rank(
+				    ranking, rbt_value(fts_ranking_t, last))
+			    >= 0) {
+				continue;
+			}
+
+			ut_free(rbt_remove_node(ranked, last));
+		}
+
 		rbt_insert(ranked, ranking, ranking);
 	}
 
@@ -4253,6 +4280,42 @@ fts_query_sort_result_on_rank(
 	result->rankings_by_rank = ranked;
 }
 
+/** Get the next document of an FTS Query result sorted by
+fts_query_sort_result_on_rank(). If only the highest ranked documents were
+sorted and all of them have been read, the rest of the result is sorted.
+@param[in,out]	result	result sorted on rank, result->current must be
+positioned on a document
+@return the next document, or NULL if the result is exhausted */
+const ib_rbt_node_t*
+fts_query_next_result_on_rank(
+	fts_result_t*	result)
+{
+	const ib_rbt_node_t*	node;
+
+	ut_ad(result->current != NULL);
+
+	node = rbt_next(result->rankings_by_rank, result->current);
+
+	if (node == NULL && result->rankings_truncated) {
+		/* The caller wants more documents than it asked for,
+		for example because some of them were not visible to it.
+		Sort the whole result. Its first documents are the ones
+		that have been read, in the same order. */
+		ulint	n_read = rbt_size(result->rankings_by_rank);
+
+		fts_query_sort_result_on_rank(result, ULINT_UNDEFINED);
+
+		for (node = rbt_first(result->rankings_by_rank);
+		     node != NULL && n_read > 0;
+		     node = rbt_next(result->rankings_by_rank, node)) {
+
+			--n_read;
+		}
+	}
+
+	return(node);
+}
+
 /*******************************************************************//**
 A debug function to print result doc_id set. */
 static
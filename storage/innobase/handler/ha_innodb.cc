@@ -94,6 +94,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "row0ins.h"
 #include "row0merge.h"
 #include "row0mysql.h"
+#include "row0pread.h"
 #include "row0quiesce.h"
 #include "row0sel.h"
 #include "row0trunc.h"
@@ -908,6 +909,12 @@ static MYSQL_THDVAR_BOOL(ft_ignore_stopwords, PLUGIN_VAR_OPCMDARG,
   "Instruct FTS to ignore stopwords.",
   NULL, NULL, FALSE);
 
+static MYSQL_THDVAR_ULONG(parallel_read_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads used to scan the clustered index when counting"
+  " the rows of a table for SELECT COUNT(*) without a WHERE clause."
+  " 1 scans it in the connection thread.",
+  NULL, NULL, 1, 1, 256, 0);
+
 static SHOW_VAR innodb_status_variables[]= {
   {"background_log_sync",
   (char*) &export_vars.innodb_background_log_sync,	  SHOW_LONG, SHOW_SCOPE_GLOBAL},
@@ -10266,6 +10273,16 @@ ha_innobase::ft_init_ext_with_hints(
 		m_prebuilt->m_fts_limit = ULONG_UNDEFINED;
 	}
 
+	/* With ORDER BY MATCH() ... LIMIT, only the highest ranked
+	documents of the result need to be sorted. */
+	if ((hints->get_flags() & FT_SORTED)
+	    && hints->get_limit() != HA_POS_ERROR
+	    && hints->get_limit() > 0) {
+		m_prebuilt->m_fts_sort_limit = hints->get_limit();
+	} else {
+		m_prebuilt->m_fts_sort_limit = ULONG_UNDEFINED;
+	}
+
 	return(ft_init_ext(hints->get_flags(), keynr, key));
 }
 
@@ -10350,7 +10367,12 @@ ha_innobase::ft_read(
 			need to sort the document ids on their rank
 			calculation. */
 
-			fts_query_sort_result_on_rank(result);
+			fts_query_sort_result_on_rank(
+				result,
+				static_cast<ulint>(ut_min(
+					m_prebuilt->m_fts_sort_limit,
+					static_cast<ulonglong>(
+						ULINT_UNDEFINED))));
 
 			result->current = const_cast<ib_rbt_node_t*>(
 				rbt_first(result->rankings_by_rank));
@@ -10359,7 +10381,7 @@ ha_innobase::ft_read(
 		}
 	} else {
 		result->current = const_cast<ib_rbt_node_t*>(
-			rbt_next(result->rankings_by_rank, result->current));
+			fts_query_next_result_on_rank(result));
 	}
 
 next_record:
@@ -10418,8 +10440,7 @@ next_record:
 			break;
 		case DB_RECORD_NOT_FOUND:
 			result->current = const_cast<ib_rbt_node_t*>(
-				rbt_next(result->rankings_by_rank,
-					 result->current));
+				fts_query_next_result_on_rank(result));
 
 			if (!result->current) {
 				/* exhaust the result set, should return
@@ -14295,8 +14316,19 @@ ha_innobase::records(
 	m_prebuilt->read_just_key = 1;
 	build_template(false);
 
-	/* Count the records in the clustered index */
-	ret = row_scan_index_for_mysql(m_prebuilt, index, false, &n_rows);
+	/* Count the records in the clustered index. A consistent read
+	can be split into key ranges scanned by several threads. */
+	const ulint	n_threads = THDVAR(m_user_thd, parallel_read_threads);
+
+	if (n_threads > 1
+	    && m_prebuilt->select_lock_type == LOCK_NONE
+	    && !dict_table_is_intrinsic(m_prebuilt->table)) {
+		ret = row_pread_count_rows(
+			m_prebuilt->trx, index, n_threads, &n_rows);
+	} else {
+		ret = row_scan_index_for_mysql(
+			m_prebuilt, index, false, &n_rows);
+	}
 	reset_template();
 	switch (ret) {
 	case DB_SUCCESS:
@@ -14304,6 +14336,7 @@ ha_innobase::records(
 	case DB_DEADLOCK:
 	case DB_LOCK_TABLE_FULL:
 	case DB_LOCK_WAIT_TIMEOUT:
+	case DB_MISSING_HISTORY:
 		*num_rows = HA_POS_ERROR;
 		DBUG_RETURN(convert_error_code_to_mysql(ret, 0, m_user_thd));
 	case DB_INTERRUPTED:
@@ -20777,6 +20810,15 @@ static MYSQL_SYSVAR_BOOL(file_per_table, srv_file_per_table,
   "Stores each InnoDB table to an .ibd file in the database dir.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(tablespace_prealloc_extents,
+  srv_tablespace_prealloc_extents,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of free extents to preallocate in the background ahead of the"
+  " size of a growing single-table or general tablespace, so that inserts"
+  " do not wait for the data file to be extended. 0 disables the"
+  " preallocation.",
+  NULL, NULL, 0, 0, 1024, 0);
+
 static MYSQL_SYSVAR_STR(file_format, innobase_file_format_name,
   PLUGIN_VAR_RQCMDARG,
   "File format to use for new tables in .ibd files.",
@@ -20957,6 +20999,15 @@ static MYSQL_SYSVAR_BOOL(stats_auto_recalc, srv_stats_auto_recalc,
   " new statistics)",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(stats_incremental_recalc,
+  srv_stats_incremental_recalc,
+  PLUGIN_VAR_OPCMDARG,
+  "When automatically recalculating persistent statistics, track the"
+  " modifications of each index and re-analyze only the indexes that have"
+  " changed too much, keeping the statistics of the other indexes"
+  " (off by default)",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONGLONG(stats_persistent_sample_pages,
   srv_stats_persistent_sample_pages,
   PLUGIN_VAR_RQCMDARG,
@@ -21782,6 +21833,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(read_io_threads),
   MYSQL_SYSVAR(write_io_threads),
   MYSQL_SYSVAR(file_per_table),
+  MYSQL_SYSVAR(tablespace_prealloc_extents),
   MYSQL_SYSVAR(file_format),
   MYSQL_SYSVAR(file_format_check),
   MYSQL_SYSVAR(file_format_max),
@@ -21807,6 +21859,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(locks_unsafe_for_binlog),
   MYSQL_SYSVAR(lock_wait_timeout),
   MYSQL_SYSVAR(deadlock_detect),
+  MYSQL_SYSVAR(parallel_read_threads),
   MYSQL_SYSVAR(page_size),
   MYSQL_SYSVAR(log_buffer_size),
   MYSQL_SYSVAR(log_file_size),
@@ -21838,6 +21891,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_persistent),
   MYSQL_SYSVAR(stats_persistent_sample_pages),
   MYSQL_SYSVAR(stats_auto_recalc),
+  MYSQL_SYSVAR(stats_incremental_recalc),
   MYSQL_SYSVAR(adaptive_hash_index),
   MYSQL_SYSVAR(adaptive_hash_index_parts),
   MYSQL_SYSVAR(stats_method),
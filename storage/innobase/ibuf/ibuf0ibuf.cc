@@ -300,6 +300,10 @@ const ulint		IBUF_MERGE_THRESHOLD = 4;
 batch, in order to merge the entries for them in the insert buffer */
 const ulint		IBUF_MAX_N_PAGES_MERGED = IBUF_MERGE_AREA;
 
+/** In ibuf_merge_in_background() at most this number of pages is read to
+memory in one asynchronous batch, see ibuf_merge_batch() */
+const ulint		IBUF_MAX_N_PAGES_MERGED_BATCH = 256;
+
 /** If the combined size of the ibuf trees exceeds ibuf->max_size by this
 many pages, we start to contract it in connection to inserts there, using
 non-synchronous contract */
@@ -2567,6 +2571,112 @@ ibuf_merge_pages(
 	return(sum_sizes + 1);
 }
 
+/** Contracts the change buffer by reading a large batch of pages to the
+buffer pool. Unlike ibuf_merge_pages() which only looks at the pages in the
+merge area of a random record, this collects the page numbers of all
+buffered changes starting from a random position of the change buffer
+tree, so that the reads are issued in ascending (space, page) order. The
+reads are asynchronous and the buffered changes are merged by the I/O
+handler threads on read completion.
+@param[out]	n_pages		number of pages to which merged
+@param[in]	limit		maximum number of pages to read
+@return a lower limit for the combined size in bytes of entries which
+will be merged from ibuf trees to the pages read, 0 if ibuf is
+empty */
+static
+ulint
+ibuf_merge_batch(
+	ulint*	n_pages,
+	ulint	limit)
+{
+	mtr_t		mtr;
+	btr_pcur_t	pcur;
+	ulint		volume = 0;
+	const rec_t*	rec;
+
+	ut_ad(limit > 0);
+
+	*n_pages = 0;
+
+	ulint*	page_nos = UT_NEW_ARRAY_NOKEY(ulint, limit);
+	ulint*	space_ids = UT_NEW_ARRAY_NOKEY(ulint, limit);
+
+	ibuf_mtr_start(&mtr);
+
+	/* Open a cursor to a randomly chosen leaf of the tree, at a random
+	position within the leaf */
+	bool available;
+
+	available = btr_pcur_open_at_rnd_pos(ibuf->index, BTR_SEARCH_LEAF,
+					     &pcur, &mtr);
+	/* No one should make this index unavailable when server is running */
+	ut_a(available);
+
+	ut_ad(page_validate(btr_pcur_get_page(&pcur), ibuf->index));
+
+	if (page_is_empty(btr_pcur_get_page(&pcur))) {
+		/* If a B-tree page is empty, it must be the root page
+		and the whole B-tree must be empty. InnoDB does not
+		allow empty B-tree pages other than the root. */
+		ut_ad(ibuf->empty);
+		ut_ad(page_get_space_id(btr_pcur_get_page(&pcur))
+		      == IBUF_SPACE_ID);
+		ut_ad(page_get_page_no(btr_pcur_get_page(&pcur))
+		      == FSP_IBUF_TREE_ROOT_PAGE_NO);
+
+		ibuf_mtr_commit(&mtr);
+		btr_pcur_close(&pcur);
+
+		UT_DELETE_ARRAY(page_nos);
+		UT_DELETE_ARRAY(space_ids);
+
+		return(0);
+	}
+
+	/* Start from the first record of the random leaf page, so that
+	the changes buffered for a page are not split across batches
+	more often than necessary */
+	btr_pcur_move_before_first_on_page(&pcur);
+
+	while ((rec = ibuf_get_user_rec(&pcur, &mtr)) != 0) {
+
+		ulint	space = ibuf_rec_get_space(&mtr, rec);
+		ulint	page_no = ibuf_rec_get_page_no(&mtr, rec);
+
+		if (*n_pages == 0
+		    || page_nos[*n_pages - 1] != page_no
+		    || space_ids[*n_pages - 1] != space) {
+
+			if (*n_pages == limit) {
+				break;
+			}
+
+			space_ids[*n_pages] = space;
+			page_nos[*n_pages] = page_no;
+			++*n_pages;
+		}
+
+		volume += ibuf_rec_get_volume(&mtr, rec);
+
+		btr_pcur_move_to_next(&pcur, &mtr);
+	}
+
+	ibuf_mtr_commit(&mtr);
+	btr_pcur_close(&pcur);
+
+	if (*n_pages > 0) {
+		MONITOR_INC(MONITOR_IBUF_MERGE_BATCHES);
+		MONITOR_INC_VALUE(MONITOR_IBUF_MERGE_BATCH_PAGES, *n_pages);
+
+		buf_read_ibuf_merge_pages(false, space_ids, page_nos, *n_pages);
+	}
+
+	UT_DELETE_ARRAY(page_nos);
+	UT_DELETE_ARRAY(space_ids);
+
+	return(volume + 1);
+}
+
 /*********************************************************************//**
 Contracts insert buffer trees by reading pages referring to space_id
 to the buffer pool.
@@ -2643,6 +2753,9 @@ ibuf_merge_space(
 @param[out]	n_pages		number of pages merged
 @param[in]	sync		whether the caller waits for
 the issued reads to complete
+@param[in]	limit		maximum number of pages to read; if this
+is more than IBUF_MAX_N_PAGES_MERGED, the pages are read in one
+asynchronous batch by ibuf_merge_batch()
 @return a lower limit for the combined size in bytes of entries which
 will be merged from ibuf trees to the pages read, 0 if ibuf is
 empty */
@@ -2650,7 +2763,8 @@ static MY_ATTRIBUTE((warn_unused_result))
 ulint
 ibuf_merge(
 	ulint*		n_pages,
-	bool		sync)
+	bool		sync,
+	ulint		limit)
 {
 	*n_pages = 0;
 
@@ -2665,6 +2779,10 @@ ibuf_merge(
 	} else if (ibuf_debug) {
 		return(0);
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
+	} else if (!sync && limit > IBUF_MAX_N_PAGES_MERGED) {
+		return(ibuf_merge_batch(
+			       n_pages,
+			       ut_min(limit, IBUF_MAX_N_PAGES_MERGED_BATCH)));
 	} else {
 		return(ibuf_merge_pages(n_pages, sync));
 	}
@@ -2731,7 +2849,7 @@ ibuf_merge_in_background(
 	while (sum_pages < n_pages) {
 		ulint	n_bytes;
 
-		n_bytes = ibuf_merge(&n_pag2, false);
+		n_bytes = ibuf_merge(&n_pag2, false, n_pages - sum_pages);
 
 		if (n_bytes == 0) {
 			return(sum_bytes);
@@ -980,6 +980,14 @@ struct dict_index_t{
 	ulint		stat_n_leaf_pages;
 				/*!< approximate number of leaf pages in the
 				index tree */
+	ib_uint64_t	stat_modified_counter;
+				/*!< how many rows may have changed their
+				key in this index since the statistics of
+				the index were last calculated; used by
+				innodb_stats_incremental_recalc to decide
+				which indexes need to be re-analyzed. Not
+				protected by any latch, this is only used
+				for heuristics */
 	/* @} */
 	last_ops_cur_t*	last_ins_cur;
 				/*!< cache the last insert position.
@@ -1620,6 +1628,12 @@ struct dict_table_t {
 	Writes are covered by dict_sys->mutex. Dirty reads are possible. */
 	byte					stats_bg_flag;
 
+	/** true if innodb_stats_incremental_recalc has added the table to
+	the background recalculation pool and the background stats thread
+	has not processed it yet. Not protected by any latch, this is only
+	used for heuristics. */
+	bool					stats_recalc_queued;
+
 	/* @} */
 
 	/** AUTOINC related members. @{ */
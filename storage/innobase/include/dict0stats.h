@@ -47,10 +47,17 @@ enum dict_stats_upd_option_t {
 				members. The resulting stats correspond to an
 				empty table. If the table is using persistent
 				statistics, then they are saved on disk. */
-	DICT_STATS_FETCH_ONLY_IF_NOT_IN_MEMORY /* fetch the stats
+	DICT_STATS_FETCH_ONLY_IF_NOT_IN_MEMORY, /* fetch the stats
 				from the persistent storage if the in-memory
 				structures have not been initialized yet,
 				otherwise do nothing */
+	DICT_STATS_RECALC_PERSISTENT_STALE /* like
+				DICT_STATS_RECALC_PERSISTENT, but only
+				re-analyze the indexes that have been
+				modified too much since their last
+				analysis (see dict_stats_index_is_stale()),
+				keeping the current estimates of the
+				other indexes */
 };
 
 /*********************************************************************//**
@@ -109,6 +116,18 @@ dict_stats_auto_recalc_is_enabled(
 /*==============================*/
 	const dict_table_t*	table);	/*!< in: table */
 
+/** Check whether an index has been modified too much since its statistics
+were last calculated and needs to be re-analyzed. Used when
+innodb_stats_incremental_recalc is enabled.
+@param[in]	index	index to check
+@param[in]	n_rows	approximate number of rows in the table
+@return true if the statistics of the index are stale */
+UNIV_INLINE
+bool
+dict_stats_index_is_stale(
+	const dict_index_t*	index,
+	ib_uint64_t		n_rows);
+
 /*********************************************************************//**
 Initialize table's stats for the first time when opening a table. */
 UNIV_INLINE
@@ -61,7 +61,7 @@ dict_stats_recalc_pool_del() */
 void
 dict_stats_recalc_pool_del(
 /*=======================*/
-	const dict_table_t*	table);	/*!< in: table to remove */
+	dict_table_t*	table);	/*!< in/out: table to remove */
 
 /** Yield the data dictionary latch when waiting
 for the background thread to stop accessing a table.
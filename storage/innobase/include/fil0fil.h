@@ -214,6 +214,13 @@ struct fil_space_t {
 	bool		is_in_unflushed_spaces;
 				/*!< true if this space is currently in
 				unflushed_spaces */
+	UT_LIST_NODE_T(fil_space_t) prealloc_spaces;
+				/*!< list of spaces waiting for the
+				tablespace preallocation thread */
+	bool		is_in_prealloc_spaces;
+				/*!< true if this space is currently in
+				prealloc_spaces; protected by
+				fil_system->mutex */
 	bool		is_corrupt;
 	UT_LIST_NODE_T(fil_space_t) space_list;
 				/*!< list of all spaces */
@@ -280,6 +287,9 @@ struct fil_node_t {
 	UT_LIST_NODE_T(fil_node_t) chain;
 	/** link to the fil_system->LRU list (keeping track of open files) */
 	UT_LIST_NODE_T(fil_node_t) LRU;
+	/** whether the file was read on the fast path of fil_io() since it
+	was last moved in fil_system->LRU; written without fil_system->mutex */
+	bool		fast_io_accessed;
 
 	/** whether the file system of this file supports PUNCH HOLE */
 	bool		punch_hole;
@@ -1176,6 +1186,26 @@ bool
 fil_space_extend(
 	fil_space_t*	space,
 	ulint		size);
+#ifndef UNIV_HOTBACKUP
+/** Ask the tablespace preallocation thread to extend the data file of a
+tablespace ahead of the size stored in its header, up to
+innodb_tablespace_prealloc_extents free extents.
+@param[in,out]	space	single-table or general tablespace */
+void
+fil_space_request_prealloc(
+	fil_space_t*	space);
+
+/** This is the tablespace preallocation thread. It waits for requests
+made by fil_space_request_prealloc() and extends the data files of the
+requested tablespaces, so that the threads inserting into them seldom
+need to extend the files themselves while holding the tablespace latch.
+@param[in]	arg	a dummy parameter required by os_thread_create.
+@return	this function does not return, calls os_thread_exit() */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(fil_prealloc_thread)(
+	void*	arg);
+#endif /* !UNIV_HOTBACKUP */
 /*******************************************************************//**
 Tries to reserve free extents in a file space.
 @return true if succeed */
@@ -287,6 +287,11 @@ struct fts_result_t {
 					indexed by doc id */
 	ib_rbt_t*	rankings_by_rank;/*!< RB tree of type fts_ranking_t
 					indexed by rank */
+	bool		rankings_truncated;
+					/*!< true if rankings_by_rank
+					holds only the highest ranked
+					documents, see
+					fts_query_sort_result_on_rank() */
 };
 
 /** This is used to generate the FTS auxiliary table name, we need the
@@ -601,13 +606,24 @@ fts_retrieve_ranking(
 	doc_id_t	doc_id);		/*!< in: the interested document
 						doc_id */
 
-/******************************************************************//**
-FTS Query sort result, returned by fts_query() on fts_ranking_t::rank. */
+/** FTS Query sort result, returned by fts_query() on fts_ranking_t::rank.
+@param[in,out]	result	result instance to sort
+@param[in]	limit	number of the highest ranked documents that the
+caller is going to read, or ULINT_UNDEFINED to sort all of them */
 void
 fts_query_sort_result_on_rank(
-/*==========================*/
-	fts_result_t*	result);		/*!< out: result instance
-						to sort.*/
+	fts_result_t*	result,
+	ulint		limit);
+
+/** Get the next document of an FTS Query result sorted by
+fts_query_sort_result_on_rank(). If only the highest ranked documents were
+sorted and all of them have been read, the rest of the result is sorted.
+@param[in,out]	result	result sorted on rank, result->current must be
+positioned on a document
+@return the next document, or NULL if the result is exhausted */
+const ib_rbt_node_t*
+fts_query_next_result_on_rank(
+	fts_result_t*	result);
 
 /******************************************************************//**
 FTS Query free result, returned by fts_query(). */
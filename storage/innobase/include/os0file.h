@@ -584,7 +584,11 @@ public:
 		This can be used to force a read and write without any
 		compression e.g., for redo log, merge sort temporary files
 		and the truncate redo log. */
-		NO_COMPRESSION = 512
+		NO_COMPRESSION = 512,
+
+		/** The file node was pinned by the fast path of fil_io()
+		without acquiring fil_system->mutex. Set by fil_io() only. */
+		FIL_NODE_PINNED = 1024
 	};
 
 	/** Default constructor */
@@ -669,6 +673,20 @@ public:
 		m_type |= DISABLE_PARTIAL_IO_WARNINGS;
 	}
 
+	/** @return true if the file node was pinned by the fast path of
+	fil_io() */
+	bool is_fil_node_pinned() const
+		MY_ATTRIBUTE((warn_unused_result))
+	{
+		return((m_type & FIL_NODE_PINNED) == FIL_NODE_PINNED);
+	}
+
+	/** Mark the file node as pinned by the fast path of fil_io() */
+	void set_fil_node_pinned()
+	{
+		m_type |= FIL_NODE_PINNED;
+	}
+
 	/** @return true if missing files should be ignored */
 	bool ignore_missing() const
 		MY_ATTRIBUTE((warn_unused_result))
@@ -1002,6 +1002,10 @@ struct row_prebuilt_t {
 	/** limit value to avoid fts result overflow */
 	ulonglong	m_fts_limit;
 
+	/** number of documents that will be read from an fts result
+	sorted on rank, or ULONG_UNDEFINED if not known */
+	ulonglong	m_fts_sort_limit;
+
 	/** True if exceeded the end_range while filling the prefetch cache. */
 	bool		m_end_range;
 };
@@ -0,0 +1,56 @@
+/*****************************************************************************
+
+Copyright (c) 2018, Percona Inc. All Rights Reserved.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/row0pread.h
+Parallel read of a clustered index.
+
+The clustered index is split into disjoint key ranges at the node pointers
+of one of its upper levels, and the ranges are scanned by several threads
+which share the read view of the transaction.
+*******************************************************/
+
+#ifndef row0pread_h
+#define row0pread_h
+
+#include "univ.i"
+#include "dict0types.h"
+#include "trx0types.h"
+
+/** Number of key ranges per thread the clustered index is split into, so
+that the threads remain busy when the ranges are of unequal size. */
+#define ROW_PREAD_RANGES_PER_THREAD	4
+
+/** Count the records of a clustered index that are visible to the
+transaction, scanning key ranges of the index in parallel. The records are
+read as in a consistent read: the caller must not need any record locks.
+@param[in,out]	trx		transaction
+@param[in]	index		clustered index
+@param[in]	n_threads	maximum number of threads to scan with,
+				including the calling thread
+@param[out]	n_rows		number of visible records
+@return DB_SUCCESS, DB_INTERRUPTED or DB_MISSING_HISTORY */
+dberr_t
+row_pread_count_rows(
+	trx_t*		trx,
+	dict_index_t*	index,
+	ulint		n_threads,
+	ulint*		n_rows)
+	MY_ATTRIBUTE((warn_unused_result));
+
+#endif /* row0pread_h */
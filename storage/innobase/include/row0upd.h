@@ -385,6 +385,17 @@ row_upd_changes_some_index_ord_field_binary(
 /*========================================*/
 	const dict_table_t*	table,	/*!< in: table */
 	const upd_t*		update);/*!< in: update vector for the row */
+/** Checks if an update vector may change an ordering field of the given
+index. Unlike row_upd_changes_ord_field_binary() this does not compare
+the old and new values, it only looks at which columns are updated.
+@param[in]	index	index of the table
+@param[in]	update	update vector for the row
+@return true if an ordering column of the index is updated */
+bool
+row_upd_changes_index_ord_field(
+	const dict_index_t*	index,
+	const upd_t*		update)
+	MY_ATTRIBUTE((warn_unused_result));
 /** Stores to the heap the row on which the node->pcur is positioned.
 @param[in]	node		row update node
 @param[in]	thd		mysql thread handle
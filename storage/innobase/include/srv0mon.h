@@ -356,6 +356,9 @@ enum monitor_id_t {
 	/* Tablespace related counters */
 	MONITOR_MODULE_FIL_SYSTEM,
 	MONITOR_OVLD_N_FILE_OPENED,
+	MONITOR_TABLESPACE_EXTEND_STALLS,
+	MONITOR_TABLESPACE_EXTEND_STALL_TIME,
+	MONITOR_TABLESPACE_PREALLOC_PAGES,
 
 	/* InnoDB Change Buffer related counters */
 	MONITOR_MODULE_IBUF_SYSTEM,
@@ -367,6 +370,8 @@ enum monitor_id_t {
 	MONITOR_OVLD_IBUF_MERGE_DISCARD_PURGE,
 	MONITOR_OVLD_IBUF_MERGES,
 	MONITOR_OVLD_IBUF_SIZE,
+	MONITOR_IBUF_MERGE_BATCHES,
+	MONITOR_IBUF_MERGE_BATCH_PAGES,
 
 	/* Counters for server operations */
 	MONITOR_MODULE_SERVER,
@@ -160,6 +160,9 @@ extern os_event_t	srv_buf_dump_event;
 /** The buffer pool resize thread waits on this event. */
 extern os_event_t	srv_buf_resize_event;
 
+/** The tablespace preallocation thread waits on this event. */
+extern os_event_t	srv_fil_prealloc_event;
+
 /** The buffer pool dump/load file name */
 #define SRV_BUF_DUMP_FILENAME_DEFAULT	"ib_buffer_pool"
 extern char*		srv_buf_dump_filename;
@@ -230,6 +233,9 @@ extern my_bool	high_level_read_only;
 /** store to its own file each table created by an user; data
 dictionary tables are in the system tablespace 0 */
 extern my_bool	srv_file_per_table;
+/** Number of free extents that the background preallocation thread keeps
+allocated ahead of the size in the header of a growing tablespace */
+extern ulong	srv_tablespace_prealloc_extents;
 /** Sleep delay for threads waiting to enter InnoDB. In micro-seconds. */
 extern	ulong	srv_thread_sleep_delay;
 /** Maximum sleep delay (in micro-seconds), value of 0 disables it.*/
@@ -443,6 +449,7 @@ extern unsigned long long	srv_stats_transient_sample_pages;
 extern my_bool			srv_stats_persistent;
 extern unsigned long long	srv_stats_persistent_sample_pages;
 extern my_bool			srv_stats_auto_recalc;
+extern my_bool			srv_stats_incremental_recalc;
 extern my_bool			srv_stats_include_delete_marked;
 
 extern ibool	srv_use_doublewrite_buf;
@@ -489,6 +496,9 @@ extern ibool	srv_buf_dump_thread_active;
 /* true during the lifetime of the buffer pool resize thread */
 extern bool	srv_buf_resize_thread_active;
 
+/* true during the lifetime of the tablespace preallocation thread */
+extern bool	srv_fil_prealloc_thread_active;
+
 /* TRUE during the lifetime of the stats thread */
 extern ibool	srv_dict_stats_thread_active;
 
@@ -1532,6 +1532,9 @@ row_create_prebuilt(
 	prebuilt->m_no_prefetch = false;
 	prebuilt->m_read_virtual_key = false;
 
+	prebuilt->m_fts_limit = ULONG_UNDEFINED;
+	prebuilt->m_fts_sort_limit = ULONG_UNDEFINED;
+
 	DBUG_RETURN(prebuilt);
 }
 
@@ -1715,6 +1718,48 @@ row_get_prebuilt_insert_row(
 	return(prebuilt->ins_node->row);
 }
 
+/** Updates the modification counters of the indexes of a table. If an
+index has been modified too much since its statistics were calculated,
+the table is added to the background statistics recalculation pool so
+that only the stale indexes are re-analyzed. Used when
+innodb_stats_incremental_recalc is enabled.
+@param[in,out]	table	table
+@param[in]	update	update vector of an UPDATE, or NULL if a row was
+inserted or deleted (which modifies all the indexes)
+@param[in]	n_rows	approximate number of rows in the table */
+static
+void
+row_update_index_statistics_if_needed(
+	dict_table_t*	table,
+	const upd_t*	update,
+	ib_uint64_t	n_rows)
+{
+	bool	is_stale = false;
+
+	for (dict_index_t* index = dict_table_get_first_index(table);
+	     index != NULL;
+	     index = dict_table_get_next_index(index)) {
+
+		if (update != NULL
+		    && !row_upd_changes_index_ord_field(index, update)) {
+			continue;
+		}
+
+		index->stat_modified_counter++;
+
+		is_stale = is_stale || dict_stats_index_is_stale(index, n_rows);
+	}
+
+	/* The counters of the stale indexes stay above the threshold
+	until the background thread re-analyzes them, do not enqueue the
+	table again for every row until then */
+	if (is_stale && !table->stats_recalc_queued) {
+		table->stats_recalc_queued = true;
+		dict_stats_recalc_pool_add(table);
+		table->stat_modified_counter = 0;
+	}
+}
+
 /*********************************************************************//**
 Updates the table modification counter and calculates new estimates
 for table and index statistics if necessary. */
@@ -1722,7 +1767,9 @@ UNIV_INLINE
 void
 row_update_statistics_if_needed(
 /*============================*/
-	dict_table_t*	table)	/*!< in: table */
+	dict_table_t*	table,	/*!< in: table */
+	const upd_t*	update)	/*!< in: update vector of an UPDATE,
+				or NULL for an INSERT or DELETE */
 {
 	ib_uint64_t	counter;
 	ib_uint64_t	n_rows;
@@ -1740,9 +1787,15 @@ row_update_statistics_if_needed(
 	n_rows = dict_table_get_n_rows(table);
 
 	if (dict_stats_is_persistent_enabled(table)) {
-		if (counter > n_rows / 10 /* 10% */
+		if (srv_stats_incremental_recalc
 		    && dict_stats_auto_recalc_is_enabled(table)) {
 
+			row_update_index_statistics_if_needed(
+				table, update, n_rows);
+
+		} else if (counter > n_rows / 10 /* 10% */
+			   && dict_stats_auto_recalc_is_enabled(table)) {
+
 			dict_stats_recalc_pool_add(table);
 			table->stat_modified_counter = 0;
 		}
@@ -2374,7 +2427,7 @@ error_exit:
 	with a latch. */
 	dict_table_n_rows_inc(table);
 
-	row_update_statistics_if_needed(table);
+	row_update_statistics_if_needed(table, NULL);
 	trx->op_info = "";
 
 	if (blob_heap != NULL) {
@@ -3188,7 +3241,8 @@ run_again:
 			srv_stats.n_rows_updated.add((size_t)trx->id, 1);
 		}
 
-		row_update_statistics_if_needed(node->table);
+		row_update_statistics_if_needed(
+			node->table, node->is_delete ? NULL : node->update);
 		que_graph_free_recursive(node);
 	}
 
@@ -3208,7 +3262,8 @@ run_again:
 	that changes indexed columns, UPDATEs that change only non-indexed
 	columns would not affect statistics. */
 	if (node->is_delete || !(node->cmpl_info & UPD_NODE_NO_ORD_CHANGE)) {
-		row_update_statistics_if_needed(prebuilt->table);
+		row_update_statistics_if_needed(
+			prebuilt->table, node->is_delete ? NULL : node->update);
 	}
 
 	trx->op_info = "";
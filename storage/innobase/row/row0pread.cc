@@ -0,0 +1,429 @@
+/*****************************************************************************
+
+Copyright (c) 2018, Percona Inc. All Rights Reserved.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file row/row0pread.cc
+Parallel read of a clustered index.
+*******************************************************/
+
+#include "ha_prototypes.h"
+
+#include "row0pread.h"
+#include "btr0btr.h"
+#include "btr0cur.h"
+#include "btr0pcur.h"
+#include "dict0dict.h"
+#include "os0thread.h"
+#include "read0read.h"
+#include "rem0cmp.h"
+#include "row0row.h"
+#include "row0vers.h"
+#include "trx0trx.h"
+
+#include <vector>
+
+/** State shared by the threads of a parallel read. */
+struct row_pread_ctx_t {
+	trx_t*			trx;	/*!< transaction whose read view
+					is used by all the threads */
+	dict_index_t*		index;	/*!< clustered index */
+	std::vector<dtuple_t*>	bounds;	/*!< range boundaries: range i
+					is [bounds[i - 1], bounds[i]),
+					with the first and the last range
+					open on the left and on the right */
+	ulint			next_range;
+					/*!< the next range to be scanned,
+					incremented atomically */
+	bool			abort;	/*!< set when a thread has failed,
+					to make the others stop */
+};
+
+/** A thread of a parallel read. */
+struct row_pread_thread_t {
+	row_pread_ctx_t*	ctx;	/*!< shared state */
+	ulint			n_rows;	/*!< number of visible records
+					counted by this thread */
+	dberr_t			err;	/*!< error of this thread */
+	os_thread_id_t		id;	/*!< thread handle */
+};
+
+/** Count the visible records of one key range of the clustered index.
+@param[in,out]	trx	transaction
+@param[in]	index	clustered index
+@param[in]	start	lower bound of the range (inclusive), or NULL to start
+			from the beginning of the index
+@param[in]	end	upper bound of the range (exclusive), or NULL to scan
+			to the end of the index
+@param[out]	n_rows	number of visible records in the range
+@return DB_SUCCESS, DB_INTERRUPTED or DB_MISSING_HISTORY */
+static
+dberr_t
+row_pread_count_range(
+	trx_t*			trx,
+	dict_index_t*		index,
+	const dtuple_t*		start,
+	const dtuple_t*		end,
+	ulint*			n_rows)
+{
+	mtr_t		mtr;
+	btr_pcur_t	pcur;
+	dberr_t		err = DB_SUCCESS;
+	ulint		n = 0;
+	const bool	comp = dict_table_is_comp(index->table);
+	ReadView*	view = MVCC::is_view_active(trx->read_view)
+		? trx->read_view : NULL;
+	mem_heap_t*	heap = mem_heap_create(UNIV_PAGE_SIZE / 4);
+
+	mtr_start(&mtr);
+
+	if (start == NULL) {
+		btr_pcur_open_at_index_side(
+			true, index, BTR_SEARCH_LEAF, &pcur, true, 0, &mtr);
+	} else {
+		btr_pcur_open(index, start, PAGE_CUR_GE, BTR_SEARCH_LEAF,
+			      &pcur, &mtr);
+	}
+
+	for (;;) {
+		const rec_t*	rec = btr_pcur_get_rec(&pcur);
+		ulint*		offsets;
+
+		if (page_rec_is_infimum(rec)) {
+			btr_pcur_move_to_next_on_page(&pcur);
+			continue;
+		}
+
+		if (page_rec_is_supremum(rec)) {
+
+			if (trx_is_interrupted(trx)) {
+				err = DB_INTERRUPTED;
+				break;
+			}
+
+			if (btr_pcur_is_after_last_in_tree(&pcur, &mtr)) {
+				break;
+			}
+
+			if (rw_lock_get_waiters(dict_index_get_lock(index))) {
+				/* There are waiters on the index tree
+				lock. Store the position on the last user
+				record of the page and yield, as in
+				row_merge_read_clustered_index(). */
+				btr_pcur_move_to_prev_on_page(&pcur);
+				btr_pcur_store_position(&pcur, &mtr);
+				mtr_commit(&mtr);
+
+				os_thread_yield();
+
+				mtr_start(&mtr);
+				/* Restore position on the record, or its
+				predecessor if the record was purged
+				meanwhile, and move to its successor. */
+				btr_pcur_restore_position(
+					BTR_SEARCH_LEAF, &pcur, &mtr);
+				if (!btr_pcur_move_to_next(&pcur, &mtr)) {
+					break;
+				}
+			} else {
+				btr_pcur_move_to_next_page(&pcur, &mtr);
+			}
+			continue;
+		}
+
+		mem_heap_empty(heap);
+
+		offsets = rec_get_offsets(rec, index, NULL,
+					  ULINT_UNDEFINED, &heap);
+
+		if (end != NULL && cmp_dtuple_rec(end, rec, offsets) <= 0) {
+			break;
+		}
+
+		if (view != NULL
+		    && !view->changes_visible(
+			    row_get_rec_trx_id(rec, index, offsets),
+			    index->table->name)) {
+			rec_t*	old_vers;
+
+			err = row_vers_build_for_consistent_read(
+				rec, &mtr, index, &offsets, view, &heap,
+				heap, &old_vers, NULL);
+
+			if (err != DB_SUCCESS) {
+				break;
+			}
+
+			rec = old_vers;
+		}
+
+		if (rec != NULL && !rec_get_deleted_flag(rec, comp)) {
+			n++;
+		}
+
+		btr_pcur_move_to_next_on_page(&pcur);
+	}
+
+	mtr_commit(&mtr);
+	btr_pcur_close(&pcur);
+	mem_heap_free(heap);
+
+	*n_rows = n;
+
+	return(err);
+}
+
+/** Scan the ranges of a parallel read until there are none left.
+@param[in,out]	thr	thread of the parallel read */
+static
+void
+row_pread_scan_ranges(
+	row_pread_thread_t*	thr)
+{
+	row_pread_ctx_t*	ctx = thr->ctx;
+	const ulint		n_ranges = ctx->bounds.size() + 1;
+
+	thr->n_rows = 0;
+	thr->err = DB_SUCCESS;
+
+	while (!ctx->abort) {
+		const ulint	i = os_atomic_increment_ulint(
+			&ctx->next_range, 1) - 1;
+		ulint		n_rows;
+
+		if (i >= n_ranges) {
+			break;
+		}
+
+		thr->err = row_pread_count_range(
+			ctx->trx, ctx->index,
+			i == 0 ? NULL : ctx->bounds[i - 1],
+			i == n_ranges - 1 ? NULL : ctx->bounds[i],
+			&n_rows);
+
+		if (thr->err != DB_SUCCESS) {
+			ctx->abort = true;
+			break;
+		}
+
+		thr->n_rows += n_rows;
+	}
+}
+
+/** Thread function of a parallel read.
+@param[in,out]	arg	row_pread_thread_t of the thread
+@return a dummy value */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_pread_thread)(
+	void*	arg)
+{
+	row_pread_scan_ranges(static_cast<row_pread_thread_t*>(arg));
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Count the records on a level of the index. The level is traversed in
+a mini-transaction of its own, holding an S-latch on the index tree, as in
+dict_stats_analyze_index_level().
+@param[in]	index	index
+@param[in]	level	level of the tree
+@return number of records on the level, 0 if the tree has become lower */
+static
+ulint
+row_pread_count_level(
+	dict_index_t*	index,
+	ulint		level)
+{
+	mtr_t		mtr;
+	btr_pcur_t	pcur;
+	ulint		n_recs = 0;
+
+	mtr_start(&mtr);
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	if (level <= btr_height_get(index, &mtr)) {
+		btr_pcur_open_at_index_side(
+			true, index, BTR_SEARCH_TREE | BTR_ALREADY_S_LATCHED,
+			&pcur, true, level, &mtr);
+
+		do {
+			n_recs += page_get_n_recs(btr_pcur_get_page(&pcur));
+			btr_pcur_move_to_last_on_page(&pcur, &mtr);
+		} while (btr_pcur_move_to_next(&pcur, &mtr));
+
+		btr_pcur_close(&pcur);
+	}
+
+	mtr_commit(&mtr);
+
+	return(n_recs);
+}
+
+/** Split the clustered index into key ranges for a parallel read. The
+boundaries are node pointers of the root page or, when the root page has
+too few of them, of the level below the root. The tree may change between
+the passes over it: this only makes the ranges less even.
+@param[in,out]	ctx		parallel read; ctx->bounds is filled in
+@param[in]	n_ranges	desired number of ranges
+@param[in,out]	heap		memory heap for the boundaries */
+static
+void
+row_pread_split(
+	row_pread_ctx_t*	ctx,
+	ulint			n_ranges,
+	mem_heap_t*		heap)
+{
+	dict_index_t*	index = ctx->index;
+	mtr_t		mtr;
+	btr_pcur_t	pcur;
+
+	mtr_start(&mtr);
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+	ulint		level = btr_height_get(index, &mtr);
+	mtr_commit(&mtr);
+
+	if (level == 0) {
+		/* The index consists of the root page only. */
+		return;
+	}
+
+	ulint		n_recs = row_pread_count_level(index, level);
+
+	if (n_recs < n_ranges && level > 1) {
+		/* There are at most n_ranges pages on the level below
+		the root. */
+		level--;
+		n_recs = row_pread_count_level(index, level);
+	}
+
+	if (n_recs < 2) {
+		return;
+	}
+
+	/* Take every stride'th node pointer as a boundary. The first
+	node pointer of the level is skipped: it is the minimum record
+	and the first range starts from the beginning of the index. */
+	const ulint	stride = ut_max(n_recs / n_ranges, ulint(1));
+	const ulint	n_fields = dict_index_get_n_unique_in_tree(index);
+
+	mtr_start(&mtr);
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	if (level <= btr_height_get(index, &mtr)) {
+		ulint	i = 0;
+
+		btr_pcur_open_at_index_side(
+			true, index, BTR_SEARCH_TREE | BTR_ALREADY_S_LATCHED,
+			&pcur, true, level, &mtr);
+		btr_pcur_move_to_next_on_page(&pcur);
+
+		for (; btr_pcur_is_on_user_rec(&pcur);
+		     btr_pcur_move_to_next_user_rec(&pcur, &mtr), i++) {
+
+			if (i > 0 && i % stride == 0) {
+				ctx->bounds.push_back(
+					dict_index_build_data_tuple(
+						index,
+						btr_pcur_get_rec(&pcur),
+						n_fields, heap));
+			}
+		}
+
+		btr_pcur_close(&pcur);
+	}
+
+	mtr_commit(&mtr);
+}
+
+/** Count the records of a clustered index that are visible to the
+transaction, scanning key ranges of the index in parallel. The records are
+read as in a consistent read: the caller must not need any record locks.
+@param[in,out]	trx		transaction
+@param[in]	index		clustered index
+@param[in]	n_threads	maximum number of threads to scan with,
+				including the calling thread
+@param[out]	n_rows		number of visible records
+@return DB_SUCCESS, DB_INTERRUPTED or DB_MISSING_HISTORY */
+dberr_t
+row_pread_count_rows(
+	trx_t*		trx,
+	dict_index_t*	index,
+	ulint		n_threads,
+	ulint*		n_rows)
+{
+	ut_ad(dict_index_is_clust(index));
+	ut_ad(n_threads > 0);
+
+	trx_start_if_not_started(trx, false);
+
+	if (trx->isolation_level > TRX_ISO_READ_UNCOMMITTED) {
+		trx_assign_read_view(trx);
+	}
+
+	mem_heap_t*		heap = mem_heap_create(1024);
+	row_pread_ctx_t		ctx;
+
+	ctx.trx = trx;
+	ctx.index = index;
+	ctx.next_range = 0;
+	ctx.abort = false;
+
+	if (n_threads > 1) {
+		row_pread_split(
+			&ctx, n_threads * ROW_PREAD_RANGES_PER_THREAD, heap);
+	}
+
+	/* Do not start more threads than there are ranges. */
+	n_threads = ut_min(n_threads, ctx.bounds.size() + 1);
+
+	std::vector<row_pread_thread_t>	threads(n_threads);
+
+	for (ulint i = 0; i < n_threads; i++) {
+		threads[i].ctx = &ctx;
+	}
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_create(row_pread_thread, &threads[i],
+				 &threads[i].id);
+	}
+
+	/* The calling thread takes part in the scan. */
+	row_pread_scan_ranges(&threads[0]);
+
+	for (ulint i = 1; i < n_threads; i++) {
+		os_thread_join(threads[i].id);
+	}
+
+	dberr_t		err = DB_SUCCESS;
+
+	*n_rows = 0;
+
+	for (ulint i = 0; i < n_threads; i++) {
+		*n_rows += threads[i].n_rows;
+
+		if (err == DB_SUCCESS) {
+			err = threads[i].err;
+		}
+	}
+
+	mem_heap_free(heap);
+
+	return(err);
+}
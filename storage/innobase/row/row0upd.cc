@@ -1783,6 +1783,52 @@ row_upd_changes_some_index_ord_field_binary(
 	return(FALSE);
 }
 
+/** Checks if an update vector may change an ordering field of the given
+index. Unlike row_upd_changes_ord_field_binary() this does not compare
+the old and new values, it only looks at which columns are updated.
+@param[in]	index	index of the table
+@param[in]	update	update vector for the row
+@return true if an ordering column of the index is updated */
+bool
+row_upd_changes_index_ord_field(
+	const dict_index_t*	index,
+	const upd_t*		update)
+{
+	const dict_index_t*	clust_index
+		= dict_table_get_first_index(index->table);
+
+	for (ulint i = 0; i < upd_get_n_fields(update); i++) {
+
+		const upd_field_t*	upd_field
+			= upd_get_nth_field(update, i);
+
+		if (upd_fld_is_virtual_col(upd_field)) {
+			/* The clustered index never contains
+			virtual columns */
+			if (!dict_index_is_clust(index)
+			    && dict_index_contains_col_or_prefix(
+				    index, upd_field->field_no, true)) {
+				return(true);
+			}
+		} else if (dict_index_is_clust(index)) {
+			/* Only the primary key columns are ordering
+			fields of the clustered index */
+			if (upd_field->field_no
+			    < dict_index_get_n_unique(clust_index)) {
+				return(true);
+			}
+		} else if (dict_index_contains_col_or_prefix(
+				   index,
+				   dict_col_get_no(dict_index_get_nth_col(
+					   clust_index, upd_field->field_no)),
+				   false)) {
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
 /***********************************************************//**
 Checks if an FTS Doc ID column is affected by an UPDATE.
 @return whether the Doc ID column is changed */
@@ -1052,6 +1052,24 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DISPLAY_CURRENT | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_N_FILE_OPENED},
 
+	{"file_extend_stalls", "file_system",
+	 "Number of times a thread had to extend a tablespace file"
+	 " while inserting",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_TABLESPACE_EXTEND_STALLS},
+
+	{"file_extend_stall_time", "file_system",
+	 "Time (in microseconds) threads spent extending tablespace files"
+	 " while inserting",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_TABLESPACE_EXTEND_STALL_TIME},
+
+	{"file_prealloc_pages", "file_system",
+	 "Number of pages preallocated in tablespace files in the background"
+	 " (innodb_tablespace_prealloc_extents)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_TABLESPACE_PREALLOC_PAGES},
+
 	/* ========== Counters for Change Buffer ========== */
 	{"module_ibuf_system", "change_buffer", "InnoDB Change Buffer",
 	 MONITOR_MODULE,
@@ -1103,6 +1121,17 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_IBUF_SIZE},
 
+	{"ibuf_merge_batches", "change_buffer",
+	 "Number of batches of page reads issued by background change"
+	 " buffer merge",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_BATCHES},
+
+	{"ibuf_merge_batch_pages", "change_buffer",
+	 "Number of pages read in batches by background change buffer merge",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_BATCH_PAGES},
+
 	/* ========== Counters for server operations ========== */
 	{"module_innodb", "innodb",
 	 "Counter for general InnoDB server wide operations and properties",
@@ -97,6 +97,8 @@ ibool	srv_buf_dump_thread_active = FALSE;
 
 bool	srv_buf_resize_thread_active = false;
 
+bool	srv_fil_prealloc_thread_active = false;
+
 ibool	srv_dict_stats_thread_active = FALSE;
 
 const char*	srv_main_thread_op_info = "";
@@ -166,6 +168,10 @@ my_bool	srv_read_only_mode;
 /** store to its own file each table created by an user; data
 dictionary tables are in the system tablespace 0 */
 my_bool	srv_file_per_table;
+/** Number of free extents that the background preallocation thread keeps
+allocated in the data file of a growing single-table or general tablespace
+ahead of the size stored in its header; 0 disables the preallocation */
+ulong	srv_tablespace_prealloc_extents = 0;
 /** The file format to use on new *.ibd files. */
 ulint	srv_file_format = 0;
 /** Whether to check file format during startup.  A value of
@@ -449,6 +455,10 @@ my_bool		srv_stats_persistent = TRUE;
 my_bool		srv_stats_include_delete_marked = FALSE;
 unsigned long long	srv_stats_persistent_sample_pages = 20;
 my_bool		srv_stats_auto_recalc = TRUE;
+/* When automatically recalculating persistent statistics, track the
+modifications of each index and re-analyze only the indexes that have
+changed too much instead of the whole table */
+my_bool		srv_stats_incremental_recalc = FALSE;
 
 ibool	srv_use_doublewrite_buf	= TRUE;
 
@@ -682,6 +692,9 @@ os_event_t	srv_buf_dump_event;
 /** Event to signal the buffer pool resize thread */
 os_event_t	srv_buf_resize_event;
 
+/** Event to signal the tablespace preallocation thread */
+os_event_t	srv_fil_prealloc_event;
+
 /** The buffer pool dump/load file name */
 char*	srv_buf_dump_filename;
 
@@ -1095,6 +1108,8 @@ srv_init(void)
 
 		srv_buf_dump_event = os_event_create(0);
 
+		srv_fil_prealloc_event = os_event_create(0);
+
 		buf_flush_event = os_event_create("buf_flush_event");
 
 		UT_LIST_INIT(srv_sys->tasks, &que_thr_t::queue);
@@ -1153,6 +1168,7 @@ srv_free(void)
 		os_event_destroy(srv_error_event);
 		os_event_destroy(srv_monitor_event);
 		os_event_destroy(srv_buf_dump_event);
+		os_event_destroy(srv_fil_prealloc_event);
 		os_event_destroy(buf_flush_event);
 		os_event_destroy(srv_checkpoint_completed_event);
 		os_event_destroy(srv_redo_log_tracked_event);
@@ -2114,6 +2130,8 @@ srv_any_background_threads_are_active(void)
 		thread_active = "buf_resize_thread";
 	} else if (srv_dict_stats_thread_active) {
 		thread_active = "dict_stats_thread";
+	} else if (srv_fil_prealloc_thread_active) {
+		thread_active = "fil_prealloc_thread";
 	}
 
 	os_event_set(srv_error_event);
@@ -2122,6 +2140,7 @@ srv_any_background_threads_are_active(void)
 	os_event_set(lock_sys->timeout_event);
 	os_event_set(dict_stats_event);
 	os_event_set(srv_buf_resize_event);
+	os_event_set(srv_fil_prealloc_event);
 
 	return(thread_active);
 }
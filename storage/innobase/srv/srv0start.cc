@@ -1685,6 +1685,7 @@ innobase_start_or_create_for_mysql(void)
 			    + 1 /* srv_purge_coordinator_thread */
 			    + 1 /* buf_dump_thread */
 			    + 1 /* dict_stats_thread */
+			    + 1 /* fil_prealloc_thread */
 			    + 1 /* fts_optimize_thread */
 			    + 1 /* trx_rollback_or_clean_all_recovered */
 			    + 128 /* added as margin, for use of
@@ -2813,6 +2814,9 @@ files_checked:
 		/* Create the dict stats gathering thread */
 		os_thread_create(dict_stats_thread, NULL, NULL);
 
+		/* Create the tablespace preallocation thread */
+		os_thread_create(fil_prealloc_thread, NULL, NULL);
+
 		/* Create the thread that will optimize the FTS sub-system. */
 		fts_optimize_init();
 
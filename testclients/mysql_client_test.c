@@ -20945,6 +20945,211 @@ static void test_bug19894382()
 }
 
 
+#ifndef EMBEDDED_LIBRARY
+/*
+  Check that the LZ4 compressed protocol round trips result sets and
+  queries, both small packets that compress against the ones before them
+  and packets larger than the compression history.
+*/
+
+static void run_lz4_queries(MYSQL *lmysql)
+{
+  MYSQL_RES *result;
+  MYSQL_ROW row;
+  char *query;
+  ulong i;
+  int rc;
+
+  rc= mysql_query(lmysql, "SELECT seq, CONCAT('row ', seq, ' of the result')"
+                          " FROM lz4_seq ORDER BY seq");
+  myquery(rc);
+  result= mysql_use_result(lmysql);
+  mytest(result);
+  for (i= 0; (row= mysql_fetch_row(result)); i++)
+  {
+    char expected[64];
+    DIE_UNLESS(strtoul(row[0], NULL, 10) == i);
+    sprintf(expected, "row %lu of the result", i);
+    DIE_UNLESS(strcmp(row[1], expected) == 0);
+  }
+  DIE_UNLESS(i == 4096);
+  mysql_free_result(result);
+
+  /* A query and a row larger than the history */
+  query= (char *) malloc(200000);
+  DIE_UNLESS(query != NULL);
+  strcpy(query, "SELECT LENGTH('");
+  memset(query + strlen(query), 'x', 150000);
+  strcpy(query + 15 + 150000, "'), REPEAT('y', 150000)");
+  rc= mysql_query(lmysql, query);
+  free(query);
+  myquery(rc);
+  result= mysql_store_result(lmysql);
+  mytest(result);
+  row= mysql_fetch_row(result);
+  DIE_UNLESS(row != NULL);
+  DIE_UNLESS(strcmp(row[0], "150000") == 0);
+  DIE_UNLESS(strlen(row[1]) == 150000 && row[1][149999] == 'y');
+  mysql_free_result(result);
+}
+
+
+static void test_lz4_compression()
+{
+  MYSQL *lmysql;
+  MYSQL_RES *result;
+  MYSQL_ROW row;
+  uint level= 9;
+  uint get_level= 0;
+  int rc;
+
+  myheader("test_lz4_compression");
+
+  rc= mysql_query(mysql, "DROP TABLE IF EXISTS lz4_seq");
+  myquery(rc);
+  rc= mysql_query(mysql, "CREATE TABLE lz4_seq (seq INT PRIMARY KEY)");
+  myquery(rc);
+  rc= mysql_query(mysql, "INSERT INTO lz4_seq VALUES (0)");
+  myquery(rc);
+  for (level= 1; level < 4096; level*= 2)
+  {
+    char query[128];
+    sprintf(query, "INSERT INTO lz4_seq SELECT seq + %u FROM lz4_seq", level);
+    rc= mysql_query(mysql, query);
+    myquery(rc);
+  }
+
+  lmysql= mysql_client_init(NULL);
+  DIE_UNLESS(lmysql != NULL);
+  level= 9;
+  rc= mysql_options(lmysql, MYSQL_OPT_COMPRESSION_LZ4, &level);
+  DIE_UNLESS(rc == 0);
+  rc= mysql_get_option(lmysql, MYSQL_OPT_COMPRESSION_LZ4, &get_level);
+  DIE_UNLESS(rc == 0 && get_level == 9);
+  if (!mysql_real_connect(lmysql, opt_host, opt_user, opt_password,
+                          current_db, opt_port, opt_unix_socket, 0))
+  {
+    myerror("connection failed");
+    DIE_UNLESS(0);
+  }
+  DIE_UNLESS(lmysql->net.compress && lmysql->net.compress_context != NULL);
+
+  rc= mysql_query(lmysql, "SHOW SESSION STATUS LIKE 'Compression'");
+  myquery(rc);
+  result= mysql_store_result(lmysql);
+  mytest(result);
+  row= mysql_fetch_row(result);
+  DIE_UNLESS(row != NULL && strcmp(row[1], "ON") == 0);
+  mysql_free_result(result);
+
+  run_lz4_queries(lmysql);
+
+  /* Changing the level in the middle of the stream */
+  rc= mysql_query(lmysql, "SET SESSION protocol_compression_level= 1");
+  myquery(rc);
+  run_lz4_queries(lmysql);
+
+  mysql_close(lmysql);
+
+  rc= mysql_query(mysql, "DROP TABLE lz4_seq");
+  myquery(rc);
+}
+
+/*
+  Execute an INSERT for several parameter sets sent in one
+  COM_STMT_EXECUTE packet.
+*/
+
+static void test_stmt_execute_batch()
+{
+  MYSQL_STMT *stmt;
+  MYSQL_RES *result;
+  MYSQL_ROW row;
+  uchar buff[256];
+  uchar *pos;
+  int rc;
+  uint i;
+
+  myheader("test_stmt_execute_batch");
+
+  rc= mysql_query(mysql, "DROP TABLE IF EXISTS t1");
+  myquery(rc);
+  rc= mysql_query(mysql, "CREATE TABLE t1 (a INT AUTO_INCREMENT PRIMARY KEY,"
+                         " b INT, c VARCHAR(20))");
+  myquery(rc);
+
+  stmt= mysql_simple_prepare(mysql,
+                             "INSERT INTO t1 (b, c) VALUES (?, ?)");
+  check_stmt(stmt);
+
+  int4store(buff, stmt->stmt_id);
+  buff[4]= PARAMETER_BATCH;
+  int4store(buff + 5, 1);                       /* iteration count */
+  pos= buff + 9;
+  for (i= 1; i <= 3; i++)
+  {
+    if (i == 3)
+    {
+      /* c is NULL, b = 3 */
+      *pos++= 2;                                /* null bitmap */
+      *pos++= 0;                                /* types not sent again */
+      int4store(pos, i);
+      pos+= 4;
+      continue;
+    }
+    *pos++= 0;                                  /* null bitmap */
+    *pos++= (i == 1);                           /* types sent */
+    if (i == 1)
+    {
+      int2store(pos, MYSQL_TYPE_LONG);
+      int2store(pos + 2, MYSQL_TYPE_STRING);
+      pos+= 4;
+    }
+    int4store(pos, i);
+    pos+= 4;
+    *pos++= 5;
+    memcpy(pos, "batch", 5);
+    pos+= 5;
+  }
+  rc= ((*mysql->methods->advanced_command)(mysql, COM_STMT_EXECUTE,
+                                           NULL, 0, buff, pos - buff,
+                                           1, NULL) ||
+       (*mysql->methods->read_query_result)(mysql));
+  myquery(rc);
+  DIE_UNLESS(mysql_affected_rows(mysql) == 3);
+  DIE_UNLESS(mysql_insert_id(mysql) == 1);
+
+  rc= mysql_query(mysql, "SELECT COUNT(*), SUM(b), COUNT(c) FROM t1");
+  myquery(rc);
+  result= mysql_store_result(mysql);
+  mytest(result);
+  row= mysql_fetch_row(result);
+  DIE_UNLESS(strcmp(row[0], "3") == 0 && strcmp(row[1], "6") == 0 &&
+             strcmp(row[2], "2") == 0);
+  mysql_free_result(result);
+  mysql_stmt_close(stmt);
+
+  /* A statement returning a result set can't be executed in a batch */
+  stmt= mysql_simple_prepare(mysql, "SELECT * FROM t1 WHERE b = ?");
+  check_stmt(stmt);
+  int4store(buff, stmt->stmt_id);
+  buff[9]= 0;
+  buff[10]= 1;
+  int2store(buff + 11, MYSQL_TYPE_LONG);
+  int4store(buff + 13, 1);
+  rc= ((*mysql->methods->advanced_command)(mysql, COM_STMT_EXECUTE,
+                                           NULL, 0, buff, 17,
+                                           1, NULL) ||
+       (*mysql->methods->read_query_result)(mysql));
+  DIE_UNLESS(rc && mysql_errno(mysql) == ER_NOT_SUPPORTED_YET);
+  mysql_stmt_close(stmt);
+
+  rc= mysql_query(mysql, "DROP TABLE t1");
+  myquery(rc);
+}
+#endif
+
+
 static struct my_tests_st my_tests[]= {
   { "disable_query_logs", disable_query_logs },
   { "test_view_sp_list_fields", test_view_sp_list_fields },
@@ -21236,6 +21441,10 @@ static struct my_tests_st my_tests[]= {
   { "test_bug22559575", test_bug22559575 },
   { "test_bug19894382", test_bug19894382 },
   { "test_bug22028117", test_bug22028117 },
+#ifndef EMBEDDED_LIBRARY
+  { "test_lz4_compression", test_lz4_compression },
+  { "test_stmt_execute_batch", test_stmt_execute_batch },
+#endif
   { 0, 0 }
 };
 
@@ -34,6 +34,10 @@ namespace filesort_compare_unittest {
   radixsort -        requires extra memory: array of n pointers,
                      seems to be quite fast on intel *when it is appliccable*:
                      if (size <= 20 && items >= 1000 && items < 100000)
+  radix_sort_keys -  requires extra memory: array of n pointers,
+                     MSD radix sort used by filesort for keys <= 20 bytes
+  prefix_sort_keys - requires extra memory: array of n (prefix, pointer)
+                     pairs, used by filesort for longer keys
   std::sort -        requires no extra memory,
                      typically implemented with introsort/insertion sort
   std::stable_sort - requires extra memory: array of n pointers,
@@ -364,6 +368,33 @@ TEST_F(FileSortCompareTest, DISABLED_RadixSort)
   }
 }
 
+TEST_F(FileSortCompareTest, RadixSortKeys)
+{
+  std::vector<uchar*> expected(sort_keys, sort_keys + num_records);
+  std::stable_sort(expected.begin(), expected.end(),
+                   Mem_compare_memcmp(record_size));
+  for (int ix= 0; ix < num_iterations; ++ix)
+  {
+    std::vector<uchar*> keys(sort_keys, sort_keys + num_records);
+    std::vector<uchar*> scratch(num_records);
+    radix_sort_keys(&keys[0], num_records, record_size, &scratch[0]);
+    EXPECT_TRUE(keys == expected);
+  }
+}
+
+TEST_F(FileSortCompareTest, PrefixSortKeys)
+{
+  std::vector<uchar*> expected(sort_keys, sort_keys + num_records);
+  std::stable_sort(expected.begin(), expected.end(),
+                   Mem_compare_memcmp(record_size));
+  for (int ix= 0; ix < num_iterations; ++ix)
+  {
+    std::vector<uchar*> keys(sort_keys, sort_keys + num_records);
+    EXPECT_TRUE(prefix_sort_keys(&keys[0], num_records, record_size));
+    EXPECT_TRUE(keys == expected);
+  }
+}
+
 TEST_F(FileSortCompareTest, MyQsort)
 {
   size_t size= record_size;
@@ -2783,6 +2783,102 @@ TEST_F(MDLTest, UnusedBasic)
 }
 
 
+/**
+  Test that locks are acquired correctly using MDL_lock objects cached by
+  the context, both while the objects are around and after they were freed
+  as unused.
+*/
+
+TEST_F(MDLTest, UnusedCachedLock)
+{
+  MDL_request request;
+  int i;
+
+  /* The object for the table is cached on the first iteration. */
+  for (i= 0; i < 2; ++i)
+  {
+    MDL_REQUEST_INIT(&m_request,
+                     MDL_key::TABLE, db_name, table_name1, MDL_SHARED,
+                     MDL_TRANSACTION);
+    EXPECT_FALSE(m_mdl_context.try_acquire_lock(&m_request));
+    EXPECT_NE(m_null_ticket, m_request.ticket);
+    EXPECT_TRUE(m_mdl_context.
+                owns_equal_or_stronger_lock(MDL_key::TABLE, db_name,
+                                            table_name1, MDL_SHARED));
+    EXPECT_EQ(0, mdl_get_unused_locks_count());
+    m_mdl_context.release_transactional_locks();
+    EXPECT_EQ(1, mdl_get_unused_locks_count());
+  }
+
+  /* Free unused objects, including the cached one. */
+  mdl_locks_unused_locks_low_water= 0;
+  MDL_REQUEST_INIT(&request,
+                   MDL_key::TABLE, db_name, table_name2, MDL_SHARED,
+                   MDL_TRANSACTION);
+  EXPECT_FALSE(m_mdl_context.try_acquire_lock(&request));
+  EXPECT_NE(m_null_ticket, request.ticket);
+  m_mdl_context.release_transactional_locks();
+  EXPECT_EQ(0, mdl_get_unused_locks_count());
+
+  /* The destroyed object must not be used. */
+  MDL_REQUEST_INIT(&m_request,
+                   MDL_key::TABLE, db_name, table_name1, MDL_SHARED,
+                   MDL_TRANSACTION);
+  EXPECT_FALSE(m_mdl_context.try_acquire_lock(&m_request));
+  EXPECT_NE(m_null_ticket, m_request.ticket);
+  EXPECT_EQ(0, mdl_get_unused_locks_count());
+  m_mdl_context.release_transactional_locks();
+  EXPECT_EQ(0, mdl_get_unused_locks_count());
+}
+
+
+/**
+  Test that an MDL_lock object cached by one context can be freed through
+  another one, and that both contexts can be destroyed afterwards.
+*/
+
+TEST_F(MDLTest, UnusedCachedLockFreedByOther)
+{
+  MDL_context mdl_context2;
+  MDL_request request;
+
+  mdl_context2.init(this);
+
+  /* The object for the table is cached by the first context. */
+  MDL_REQUEST_INIT(&m_request,
+                   MDL_key::TABLE, db_name, table_name1, MDL_SHARED,
+                   MDL_TRANSACTION);
+  EXPECT_FALSE(m_mdl_context.try_acquire_lock(&m_request));
+  EXPECT_NE(m_null_ticket, m_request.ticket);
+  m_mdl_context.release_transactional_locks();
+  EXPECT_EQ(1, mdl_get_unused_locks_count());
+
+  /* The second context frees unused objects, including the cached one. */
+  mdl_locks_unused_locks_low_water= 0;
+  MDL_REQUEST_INIT(&request,
+                   MDL_key::TABLE, db_name, table_name2, MDL_SHARED,
+                   MDL_TRANSACTION);
+  EXPECT_FALSE(mdl_context2.try_acquire_lock(&request));
+  EXPECT_NE(m_null_ticket, request.ticket);
+  mdl_context2.release_transactional_locks();
+  EXPECT_EQ(0, mdl_get_unused_locks_count());
+
+  /* The freed object must not be pinned by the cache of the first context. */
+  mdl_context2.destroy();
+
+  MDL_REQUEST_INIT(&m_request,
+                   MDL_key::TABLE, db_name, table_name1, MDL_SHARED,
+                   MDL_TRANSACTION);
+  EXPECT_FALSE(m_mdl_context.try_acquire_lock(&m_request));
+  EXPECT_NE(m_null_ticket, m_request.ticket);
+  EXPECT_TRUE(m_mdl_context.
+              owns_equal_or_stronger_lock(MDL_key::TABLE, db_name,
+                                          table_name1, MDL_SHARED));
+  m_mdl_context.release_transactional_locks();
+  EXPECT_EQ(0, mdl_get_unused_locks_count());
+}
+
+
 /**
   More complex test in which we test freeing couple of unused
   MDL_lock objects while having another one still used and around.
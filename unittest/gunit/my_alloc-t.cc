@@ -220,4 +220,34 @@ TEST_F(MyPreAllocTest, PreAlloc)
 #endif
 }
 
+TEST_F(MyPreAllocTest, TrimRoot)
+{
+  // PREALLOCATE_MEMORY_CHUNKS is not defined for valgrind and ASAN
+#if !defined(HAVE_VALGRIND) && !defined(HAVE_ASAN)
+  size_t pre_allocated= m_prealloc_root.allocated_size;
+
+  // Eat the pre-allocated memory and allocate a few more blocks
+  for (int ix= 0; ix < 8; ++ix)
+    EXPECT_TRUE(alloc_root(&m_prealloc_root, 1000));
+  size_t allocated= m_prealloc_root.allocated_size;
+  EXPECT_LT(pre_allocated, allocated);
+
+  // Everything fits, nothing is freed and the blocks are reused
+  trim_root(&m_prealloc_root, allocated);
+  EXPECT_EQ(allocated, m_prealloc_root.allocated_size);
+  for (int ix= 0; ix < 8; ++ix)
+    EXPECT_TRUE(alloc_root(&m_prealloc_root, 1000));
+  EXPECT_EQ(allocated, m_prealloc_root.allocated_size);
+
+  // Keep only part of the blocks
+  trim_root(&m_prealloc_root, 2048);
+  EXPECT_LT(pre_allocated, m_prealloc_root.allocated_size);
+  EXPECT_GE(pre_allocated + 2048, m_prealloc_root.allocated_size);
+
+  // Same as free_root(MY_KEEP_PREALLOC)
+  trim_root(&m_prealloc_root, 0);
+  EXPECT_EQ(pre_allocated, m_prealloc_root.allocated_size);
+#endif
+}
+
 }
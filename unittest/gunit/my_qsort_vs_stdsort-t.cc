@@ -17,6 +17,7 @@
 #include "my_config.h"
 #include <gtest/gtest.h>
 #include "my_sys.h"
+#include "filesort_utils.h"
 
 #include <algorithm>
 #include <vector>
@@ -91,6 +92,111 @@ TEST_P(DoubleSortCompareTest, MyQSort)
   }
 }
 
+
+/*
+  Sorting of filesort keys: pointers to fixed-length keys which compare
+  with memcmp(). Short keys are sorted by radix_sort_keys(), long keys by
+  prefix_sort_keys(), compare them with std::stable_sort on the same data.
+*/
+class Mem_compare_keys :
+  public std::binary_function<const uchar*, const uchar*, bool>
+{
+public:
+  Mem_compare_keys(size_t n) : m_size(n) {}
+  bool operator()(const uchar *s1, const uchar *s2) const
+  {
+    return memcmp(s1, s2, m_size) < 0;
+  }
+private:
+  size_t m_size;
+};
+
+static const size_t short_key_length= 8;
+static const size_t long_key_length= 64;
+
+class KeySortCompareTest : public ::testing::TestWithParam<int>
+{
+public:
+  static void SetUpTestCase()
+  {
+    // Keys with a few leading zero bytes, like integers in a sort key.
+    key_data.resize(100000 * long_key_length);
+    for (size_t ix= 0; ix < key_data.size(); ++ix)
+      key_data[ix]= (ix % long_key_length < 3) ? 0 : (uchar) rand();
+  }
+
+  static void TearDownTestCase()
+  {
+    std::vector<uchar>().swap(key_data);
+  }
+
+  virtual void SetUp()
+  {
+    num_elements= GetParam();
+    keys.resize(num_elements);
+    for (int ix= 0; ix < num_elements; ++ix)
+      keys[ix]= &key_data[ix * long_key_length];
+  }
+
+  int num_elements;
+  std::vector<uchar*> keys;
+  static std::vector<uchar> key_data;
+};
+std::vector<uchar> KeySortCompareTest::key_data;
+
+
+int key_test_values[]= {1000, 10000, 100000};
+
+INSTANTIATE_TEST_CASE_P(Sort, KeySortCompareTest,
+                        ::testing::ValuesIn(key_test_values));
+
+TEST_P(KeySortCompareTest, StdStableSortShortKeys)
+{
+  for (size_t ix= 0; ix < num_iterations; ++ix)
+  {
+    std::vector<uchar*> data(keys);
+    std::stable_sort(data.begin(), data.end(),
+                     Mem_compare_keys(short_key_length));
+  }
+}
+
+TEST_P(KeySortCompareTest, RadixSortShortKeys)
+{
+  std::vector<uchar*> expected(keys);
+  std::stable_sort(expected.begin(), expected.end(),
+                   Mem_compare_keys(short_key_length));
+  for (size_t ix= 0; ix < num_iterations; ++ix)
+  {
+    std::vector<uchar*> data(keys);
+    std::vector<uchar*> scratch(num_elements);
+    radix_sort_keys(&data[0], num_elements, short_key_length, &scratch[0]);
+    EXPECT_TRUE(data == expected);
+  }
+}
+
+TEST_P(KeySortCompareTest, StdStableSortLongKeys)
+{
+  for (size_t ix= 0; ix < num_iterations; ++ix)
+  {
+    std::vector<uchar*> data(keys);
+    std::stable_sort(data.begin(), data.end(),
+                     Mem_compare_keys(long_key_length));
+  }
+}
+
+TEST_P(KeySortCompareTest, PrefixSortLongKeys)
+{
+  std::vector<uchar*> expected(keys);
+  std::stable_sort(expected.begin(), expected.end(),
+                   Mem_compare_keys(long_key_length));
+  for (size_t ix= 0; ix < num_iterations; ++ix)
+  {
+    std::vector<uchar*> data(keys);
+    EXPECT_TRUE(prefix_sort_keys(&data[0], num_elements, long_key_length));
+    EXPECT_TRUE(data == expected);
+  }
+}
+
 #endif  // GTEST_HAS_PARAM_TEST
 
 }
@@ -267,6 +267,10 @@ TEST_F(TableCacheBasicDeathTest, ManagerCreateAndDestroy)
   // And not three !
   EXPECT_TRUE(cache_3 == cache_1);
 
+  // The instance for the CPU the thread runs on is one of them too
+  Table_cache *local_cache= table_cache_manager.get_local_cache(get_thd(0));
+  EXPECT_TRUE(local_cache == cache_1 || local_cache == cache_2);
+
   // Both caches should be empty
   EXPECT_EQ(0U, cache_1->cached_tables());
   EXPECT_EQ(0U, cache_2->cached_tables());
@@ -300,6 +304,8 @@ TEST_F(TableCacheSingleCacheTest, CacheAddAndRemove)
 
   // There should be one TABLE in the cache after we have added table_1.
   EXPECT_EQ(1U, table_cache->cached_tables());
+  // And it should know which cache contains it.
+  EXPECT_TRUE(table_1->cache_instance == table_cache);
 
   // There should be no unused TABLE objects for the same table in the
   // cache. OTOH it should contain info about table share of table_1.
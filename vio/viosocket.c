@@ -253,6 +253,53 @@ size_t vio_write(Vio *vio, const uchar* buf, size_t size)
   DBUG_RETURN(ret);
 }
 
+
+#ifndef _WIN32
+/**
+  Write the data of an I/O vector with a single system call where possible.
+
+  @param vio     A plain socket VIO, not SSL.
+  @param iov     The pieces of data to write.
+  @param iovcnt  Number of pieces, at most IOV_MAX.
+
+  @return Number of bytes written, which may be less than the total when
+          the write was interrupted, or -1 on error.
+*/
+
+size_t vio_write_vector(Vio *vio, struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+  int flags= 0;
+  struct msghdr msg;
+  DBUG_ENTER("vio_write_vector");
+
+  DBUG_ASSERT(vio->type == VIO_TYPE_TCPIP || vio->type == VIO_TYPE_SOCKET);
+
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov= iov;
+  msg.msg_iovlen= iovcnt;
+
+  /* If timeout is enabled, do not block. */
+  if (vio->write_timeout >= 0)
+    flags= VIO_DONTWAIT;
+
+  while ((ret= mysql_socket_sendmsg(vio->mysql_socket, &msg, flags)) == -1)
+  {
+    int error= socket_errno;
+
+    /* The operation would block? */
+    if (error != SOCKET_EAGAIN && error != SOCKET_EWOULDBLOCK)
+      break;
+
+    /* Wait for the output buffer to become writable.*/
+    if ((ret= vio_socket_io_wait(vio, VIO_IO_EVENT_WRITE)))
+      break;
+  }
+
+  DBUG_RETURN(ret);
+}
+#endif
+
 #ifdef _WIN32
 static void CALLBACK cancel_io_apc(ULONG_PTR data)
 {